@@ -1,4 +1,10 @@
 #pragma once
 
+#include "components/widget.hpp"
 #include "components/Button.hpp"
 #include "components/TextureComponent.hpp"
+#include "components/HitGrid.hpp"
+#include "components/HudText.hpp"
+#include "components/Layout.hpp"
+#include "components/WidgetTree.hpp"
+#include "components/ecs.hpp"
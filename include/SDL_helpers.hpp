@@ -1,7 +1,25 @@
 #pragma once
 
 #include "helpers/helpers.hpp"
+#include "helpers/actions.hpp"
+#include "helpers/allocations.hpp"
+#include "helpers/input.hpp"
+#include "helpers/Clock.hpp"
+#include "helpers/EventDispatcher.hpp"
+#include "helpers/FrameArena.hpp"
+#include "helpers/FramePacer.hpp"
+#include "helpers/FrameStats.hpp"
+#include "helpers/InputThread.hpp"
+#include "helpers/inventory.hpp"
+#include "helpers/Profiler.hpp"
+#include "helpers/Task.hpp"
 #include "helpers/ManagedResource.hpp"
 #include "helpers/ManagedSDLTexture.hpp"
 #include "helpers/mouse.hpp"
+#include "helpers/replay.hpp"
+#include "helpers/residency.hpp"
+#include "helpers/StagingPool.hpp"
+#include "helpers/ResourcePool.hpp"
 #include "helpers/Timer.hpp"
+#include "helpers/TextureView.hpp"
+#include "helpers/TimerWheel.hpp"
@@ -1,29 +1,28 @@
 #pragma once
 
-#include <utility>
-
 #include "SDL_helpers.hpp"
+#include "components/widget.hpp"
 
+/** Draws one of three views by state. Whatever owns their texture, e.g. a sprite sheet, has to outlive it. */
 class Button {
  private:
 
-    ManagedSDLTexture texture_default_;
-    ManagedSDLTexture texture_hovering_;
-    ManagedSDLTexture texture_clicking_;
-    ManagedSDLTexture* current_texture_;
+    TextureView texture_default_;
+    TextureView texture_hovering_;
+    TextureView texture_clicking_;
 
     SDL_Rect rect_;
 
-    bool hovering_;
-    bool clicking_;
-    bool clicked_;
+    WidgetSlot slot_;
+
+    auto step(SDL_Point const& mouse, bool pressed) -> void;
 
  public:
-    template<typename ManagedSDLTexture_T>
-    Button(ManagedSDLTexture_T&& texture_default,
-           ManagedSDLTexture_T&& texture_hovering,
-           ManagedSDLTexture_T&& texture_clicking,
-           SDL_Rect const& area);
+    Button(TextureView texture_default, TextureView texture_hovering, TextureView texture_clicking, SDL_Rect const& area);
+
+    /** Keeps the button's state in the set from now on, HitGrid does this on insert */
+    auto attach(WidgetSet& set) -> void;
+    auto detach() -> void;
 
     auto isHovering() -> bool;
     auto isClicking() -> bool;
@@ -38,19 +37,7 @@ class Button {
     auto setRect(SDL_Rect const& rect) -> void;
 
     auto update() -> void;
+    auto update(InputSnapshot const& input) -> void;
 
     auto render(SDL_Renderer* renderer) -> void;
 };
-
-template<typename ManagedSDLTexture_T>
-Button::Button(ManagedSDLTexture_T&& texture_default,
-               ManagedSDLTexture_T&& texture_hovering,
-               ManagedSDLTexture_T&& texture_clicking,
-               SDL_Rect const& area):   texture_default_(std::forward<ManagedSDLTexture_T>(texture_default)),
-                                        texture_hovering_(std::forward<ManagedSDLTexture_T>(texture_hovering)),
-                                        texture_clicking_(std::forward<ManagedSDLTexture_T>(texture_clicking)),
-                                        current_texture_(&texture_default),
-                                        rect_(area),
-                                        hovering_(false),
-                                        clicking_(false),
-                                        clicked_(false) {}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "SDL_helpers.hpp"
+#include "components/widget.hpp"
+
+/**
+ * Uniform grid over widget rects for point queries. Inserted widgets keep their state in the grid's
+ * WidgetSet, so a pointer change advances all of them in one branch free pass over contiguous arrays,
+ * and a frame where the mouse is idle does no work at all. Call rebuild() after moving or resizing a widget.
+ */
+template<typename Widget_T>
+class HitGrid {
+ private:
+    int cell_size_;
+    int cols_;
+    int rows_;
+
+    std::vector<Widget_T*> widgets_;
+    std::vector<std::vector<Widget_T*>> cells_;
+    WidgetSet states_;
+    bool clicked_pending_;
+
+    auto cell(int x, int y) const -> int;
+    auto place(Widget_T* widget) -> void;
+
+ public:
+    HitGrid(int width, int height, int cell_size=64);
+    ~HitGrid();
+
+    HitGrid(HitGrid const&)                    = delete;
+    auto operator=(HitGrid const&) -> HitGrid& = delete;
+
+    auto insert(Widget_T& widget) -> void;
+    auto remove(Widget_T& widget) -> void;
+    auto rebuild() -> void;
+
+    auto at(SDL_Point const& point) const -> Widget_T*;
+    auto update(InputSnapshot const& input) -> void;
+};
+
+
+template<typename Widget_T>
+HitGrid<Widget_T>::HitGrid(int width, int height, int cell_size):   cell_size_(std::max(cell_size, 1)),
+                                                                    cols_((width  + cell_size_ - 1) / cell_size_),
+                                                                    rows_((height + cell_size_ - 1) / cell_size_),
+                                                                    widgets_(),
+                                                                    cells_(static_cast<std::size_t>(cols_ * rows_)),
+                                                                    states_(),
+                                                                    clicked_pending_(false) {}
+
+/** Widgets usually outlive the grid, so they take their state back rather than keep pointing into it */
+template<typename Widget_T>
+HitGrid<Widget_T>::~HitGrid() {
+    for (auto widget : widgets_) {
+        widget->detach();
+    }
+}
+
+template<typename Widget_T>
+auto HitGrid<Widget_T>::cell(int x, int y) const -> int {
+    if (x < 0 || y < 0 || x >= cols_ * cell_size_ || y >= rows_ * cell_size_) {
+        return -1;
+    }
+    return (y / cell_size_) * cols_ + x / cell_size_;
+}
+
+template<typename Widget_T>
+auto HitGrid<Widget_T>::place(Widget_T* widget) -> void {
+    auto const& rect = widget->rect();
+    auto x0 = std::clamp(rect.x / cell_size_, 0, cols_ - 1);
+    auto y0 = std::clamp(rect.y / cell_size_, 0, rows_ - 1);
+    auto x1 = std::clamp((rect.x + rect.w) / cell_size_, 0, cols_ - 1);
+    auto y1 = std::clamp((rect.y + rect.h) / cell_size_, 0, rows_ - 1);
+
+    for (auto y = y0; y <= y1; y++) {
+        for (auto x = x0; x <= x1; x++) {
+            cells_[static_cast<std::size_t>(y * cols_ + x)].push_back(widget);
+        }
+    }
+}
+
+
+template<typename Widget_T>
+auto HitGrid<Widget_T>::insert(Widget_T& widget) -> void {
+    widgets_.push_back(&widget);
+    widget.attach(states_);
+    place(&widget);
+}
+
+template<typename Widget_T>
+auto HitGrid<Widget_T>::remove(Widget_T& widget) -> void {
+    widgets_.erase(std::remove(widgets_.begin(), widgets_.end(), &widget), widgets_.end());
+    widget.detach();
+    rebuild();
+}
+
+template<typename Widget_T>
+auto HitGrid<Widget_T>::rebuild() -> void {
+    for (auto& c : cells_) {
+        c.clear();
+    }
+    for (auto widget : widgets_) {
+        place(widget);
+    }
+}
+
+
+/** Topmost widget under the point, widgets inserted later are on top */
+template<typename Widget_T>
+auto HitGrid<Widget_T>::at(SDL_Point const& point) const -> Widget_T* {
+    auto index = cell(point.x, point.y);
+    if (index < 0) {
+        return nullptr;
+    }
+
+    auto const& candidates = cells_[static_cast<std::size_t>(index)];
+    for (auto it = candidates.rbegin(); it != candidates.rend(); ++it) {
+        auto const& rect = (*it)->rect();
+        if (point.x > rect.x && point.x < rect.x+rect.w && point.y > rect.y && point.y < rect.y+rect.h) {
+            return *it;
+        }
+    }
+    return nullptr;
+}
+
+template<typename Widget_T>
+auto HitGrid<Widget_T>::update(InputSnapshot const& input) -> void {
+    // Widgets only change state when the pointer moves or a button changes, or to clear last frame's click
+    if (!input.moved() && !input.buttons_pressed && !input.buttons_released && !clicked_pending_) {
+        return;
+    }
+
+    clicked_pending_ = states_.update(input);
+}
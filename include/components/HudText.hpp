@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+
+#include "SDL_helpers.hpp"
+
+/**
+ * Every printable ASCII glyph of a font rasterised once into a single white texture. Text is drawn by
+ * copying glyph rects out of the strip and tinting them, so changing text costs no TTF calls and no new
+ * textures. Kerning is ignored, which suits the monospaced digits of counters and timers.
+ */
+class GlyphStrip {
+ public:
+    static constexpr char FIRST = ' ';
+    static constexpr char LAST  = '~';
+
+ private:
+    struct Glyph {
+        SDL_Rect source;
+        int      advance;
+    };
+
+    ManagedSDLTexture texture_;
+    std::array<Glyph, LAST - FIRST + 1> glyphs_;
+    int height_;
+
+    auto glyph(char c) const -> Glyph const&;
+
+ public:
+    GlyphStrip();
+
+    /** Reports errors and returns false if any glyph couldn't be rendered */
+    auto build(ManagedSDLRenderer& renderer, ManagedTTFFont& font) -> bool;
+
+    auto height() const -> int;
+    auto measure(std::string_view text) const -> SDL_Point;
+
+    /** Characters outside the strip draw as '?'. Returns where the next character would go. */
+    auto render(SDL_Renderer* renderer, std::string_view text, SDL_Point pos,
+                SDL_Colour const& colour={0xff, 0xff, 0xff, 0xff}) const -> SDL_Point;
+
+    /** Same, but as a single geometry batch whose vertex and index arrays live in the frame arena */
+    auto render(SDL_Renderer* renderer, FrameArena& arena, std::string_view text, SDL_Point pos,
+                SDL_Colour const& colour={0xff, 0xff, 0xff, 0xff}) const -> SDL_Point;
+};
+
+
+/** Fixed size text buffer built with std::to_chars. Anything past the capacity is dropped. */
+class HudText {
+ public:
+    static constexpr std::size_t CAPACITY = 128;
+
+ private:
+    std::array<char, CAPACITY> buffer_;
+    std::size_t size_;
+
+ public:
+    HudText();
+
+    auto clear() -> HudText&;
+    auto append(std::string_view text) -> HudText&;
+    /** Fixed point with the given number of decimals */
+    auto append(double value, int precision) -> HudText&;
+    template<typename Integer_T>
+        requires std::is_integral_v<Integer_T>
+    auto append(Integer_T value) -> HudText&;
+
+    auto text() const -> std::string_view;
+};
+
+
+template<typename Integer_T>
+    requires std::is_integral_v<Integer_T>
+auto HudText::append(Integer_T value) -> HudText& {
+    auto result = std::to_chars(buffer_.data() + size_, buffer_.data() + CAPACITY, value);
+    if (result.ec == std::errc{}) {
+        size_ = static_cast<std::size_t>(result.ptr - buffer_.data());
+    }
+    return *this;
+}
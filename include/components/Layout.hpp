@@ -0,0 +1,102 @@
+#pragma once
+
+#include <vector>
+
+#include "SDL_helpers.hpp"
+#include "components/TextureComponent.hpp"
+
+/**
+ * Tree of frames, stacks and grids that places widgets. Every node caches its measured size and its
+ * rect; invalidating a node only dirties its path to the root, and update() re-measures that path and
+ * re-places only the subtrees whose rect actually moved.
+ */
+class Layout {
+ public:
+    using NodeId = Uint32;
+
+    enum class Kind { frame, stack, grid, leaf };
+    enum class Axis { horizontal, vertical };
+
+ private:
+    /** What a leaf places. measure is null for widgets that only have the size they were given. */
+    struct Target {
+        void* widget;
+        void (*place)(void* widget, SDL_Rect const& rect);
+        auto (*measure)(void* widget) -> SDL_Point;
+    };
+
+    struct Node {
+        Kind   kind;
+        NodeId parent;
+        std::vector<NodeId> children;
+
+        // Stack and grid parameters
+        Axis  axis;
+        int   spacing;
+        float align;
+        int   cols;
+        int   rows;
+
+        // Placement inside a parent frame, as a fraction of the free space plus an offset
+        SDL_FPoint anchor;
+        SDL_Point  offset;
+        bool       fill;
+
+        // Negative components mean "use the content size"
+        SDL_Point size;
+        Target    target;
+
+        SDL_Point measured;
+        SDL_Rect  rect;
+        bool      measure_dirty;
+        bool      arrange_dirty;
+    };
+
+    std::vector<Node> nodes_;
+    SDL_Rect area_;
+    int placed_;
+
+    auto add(NodeId parent, Kind kind) -> NodeId;
+    auto measure(NodeId id) -> SDL_Point;
+    auto arrange(NodeId id, SDL_Rect const& rect) -> void;
+    auto leaf(NodeId parent, Target const& target, SDL_Point size) -> NodeId;
+
+ public:
+    static constexpr NodeId NONE = static_cast<NodeId>(-1);
+
+    explicit Layout(SDL_Rect const& area);
+
+    /** The root is a frame covering the whole area */
+    auto root() const -> NodeId;
+
+    auto frame(NodeId parent) -> NodeId;
+    auto stack(NodeId parent, Axis axis, int spacing=0, float align=0.5f) -> NodeId;
+    auto grid(NodeId parent, int cols, int rows, int spacing=0) -> NodeId;
+
+    /** Sized to its texture; call contentChanged() after swapping the texture */
+    auto leaf(NodeId parent, TextureComponent& component) -> NodeId;
+    /** Any widget with setRect(), at a fixed size */
+    template<typename Widget_T>
+    auto leaf(NodeId parent, Widget_T& widget, SDL_Point size) -> NodeId;
+
+    auto anchor(NodeId id, float x, float y, SDL_Point offset={0, 0}) -> Layout&;
+    auto fill(NodeId id, bool fill=true) -> Layout&;
+    auto setSize(NodeId id, SDL_Point size) -> Layout&;
+    auto setArea(SDL_Rect const& area) -> Layout&;
+
+    /** Re-reads a leaf's content size and invalidates it only if the size differs */
+    auto contentChanged(NodeId id) -> bool;
+    auto invalidate(NodeId id) -> void;
+
+    /** Brings every rect up to date, returns the number of nodes that were re-placed */
+    auto update() -> int;
+
+    auto rect(NodeId id) const -> SDL_Rect const&;
+};
+
+
+template<typename Widget_T>
+auto Layout::leaf(NodeId parent, Widget_T& widget, SDL_Point size) -> NodeId {
+    auto place = [](void* target, SDL_Rect const& rect) { static_cast<Widget_T*>(target)->setRect(rect); };
+    return leaf(parent, Target{&widget, place, nullptr}, size);
+}
@@ -3,6 +3,7 @@
 #include <utility>
 
 #include "SDL_helpers.hpp"
+#include "components/widget.hpp"
 
 class TextureComponent {
  protected:
@@ -11,9 +12,9 @@ class TextureComponent {
 
     SDL_Rect rect_;
 
-    bool hovering_;
-    bool clicking_;
-    bool clicked_;
+    WidgetSlot slot_;
+
+    auto step(SDL_Point const& mouse, bool pressed) -> void;
 
  public:
     TextureComponent();
@@ -22,6 +23,10 @@ class TextureComponent {
 
     auto texture() -> ManagedSDLTexture&;
 
+    /** Keeps the component's state in the set from now on, WidgetTree does this on add */
+    auto attach(WidgetSet& set) -> void;
+    auto detach() -> void;
+
     auto isHovering() const -> bool;
     auto isClicking() const -> bool;
     auto isClicked()  const -> bool;
@@ -39,6 +44,9 @@ class TextureComponent {
     auto setDimToTexture() -> TextureComponent&;
 
     auto update() -> void;
+    auto update(InputSnapshot const& input) -> void;
+    /** Steps the state machine with hit-testing already done, returns true if the state changed */
+    auto advance(bool inside, bool pressed) -> bool;
 
     auto render(SDL_Renderer* renderer) -> void;
 
@@ -55,6 +63,4 @@ TextureComponent::TextureComponent(Texture_T&& texture,
                                    SDL_Rect const&       area):
                                                                 texture_(std::forward<Texture_T>(texture)),
                                                                 rect_(area),
-                                                                hovering_(false),
-                                                                clicking_(false),
-                                                                clicked_(false) {}
+                                                                slot_() {}
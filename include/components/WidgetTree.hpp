@@ -0,0 +1,107 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "SDL_helpers.hpp"
+#include "components/TextureComponent.hpp"
+
+/**
+ * Retained tree of TextureComponent widgets. Pointer input is hit-tested once per change from the root
+ * down, only widgets on the hovered path or still holding state are stepped, and events bubble from the
+ * widget under the pointer up to the root. A frame where nothing moved or was pressed does no work.
+ * Widgets keep their state in the tree's WidgetSet from the moment they're added.
+ *
+ * Each node carries its own dirty flag, and marking one flags every ancestor up to the root, so dirty()
+ * is a single check and damage() only walks the subtrees that changed. render() redraws just the damaged
+ * rects into whatever is already on the target, which means the target has to keep its contents between
+ * frames; call markDirty() with no node to redraw everything after clearing it.
+ */
+class WidgetTree {
+ public:
+    using NodeId = Uint32;
+
+    enum class EventType { enter, leave, move, down, up, click };
+
+    struct Event {
+        EventType type;
+        NodeId    target;
+        NodeId    current;
+        SDL_Point point;
+    };
+
+    /** Return true to stop the event bubbling any further */
+    using Handler = std::function<bool(Event const&)>;
+
+ private:
+    struct Node {
+        TextureComponent*   widget;
+        NodeId              parent;
+        std::vector<NodeId> children;
+        Handler             handler;
+        Uint32              stepped;
+        SDL_Rect            drawn;
+        bool                visible;
+        bool                on_path;
+        bool                dirty;
+        bool                dirty_below;
+    };
+
+    std::vector<Node>   nodes_;
+    WidgetSet           states_;
+    std::vector<NodeId> path_;
+    std::vector<NodeId> next_path_;
+    std::vector<NodeId> active_;
+    std::vector<NodeId> next_active_;
+    std::vector<SDL_Rect> damage_;
+    SDL_Rect bounds_;
+    Uint32   frame_;
+    bool     clicked_pending_;
+
+    auto inside(NodeId id, SDL_Point const& point) const -> bool;
+    auto step(NodeId id, bool pressed) -> void;
+    auto send(EventType type, NodeId target, SDL_Point const& point) -> void;
+    auto bubble(EventType type, NodeId target, SDL_Point const& point) -> void;
+    auto collect(NodeId id) -> void;
+    auto render(NodeId id, SDL_Renderer* renderer, SDL_Rect const* clip) -> void;
+    auto clean(NodeId id) -> void;
+
+ public:
+    static constexpr NodeId NONE = static_cast<NodeId>(-1);
+
+    explicit WidgetTree(SDL_Rect const& bounds);
+    ~WidgetTree();
+
+    WidgetTree(WidgetTree const&)                    = delete;
+    auto operator=(WidgetTree const&) -> WidgetTree& = delete;
+
+    /** The root has no widget and covers the bounds */
+    auto root() const -> NodeId;
+
+    /** Children are drawn after, and hit-tested before, their parent and earlier siblings */
+    auto add(NodeId parent, TextureComponent& widget) -> NodeId;
+    auto on(NodeId id, Handler handler) -> WidgetTree&;
+    auto setVisible(NodeId id, bool visible) -> WidgetTree&;
+
+    /** Call after changing a widget's texture or rect. Pointer input marks the widgets it changes itself. */
+    auto markDirty(NodeId id) -> void;
+    auto markDirty() -> void;
+
+    auto widget(NodeId id) const -> TextureComponent*;
+    auto parent(NodeId id) const -> NodeId;
+    auto hovered() const -> NodeId;
+
+    /** Deepest visible widget under the point. Children are only searched inside their parent's rect. */
+    auto hit(SDL_Point const& point) const -> NodeId;
+
+    /** Returns false without touching any widget if the pointer neither moved nor changed buttons */
+    auto update(InputSnapshot const& input) -> bool;
+
+    auto dirty() const -> bool;
+
+    /** Where the widgets that changed were last drawn and where they are now, or the bounds if the root is dirty */
+    auto damage() -> std::vector<SDL_Rect> const&;
+
+    /** Redraws every widget that overlaps the damage, clipped to it, and skips subtrees that don't */
+    auto render(SDL_Renderer* renderer) -> void;
+};
@@ -0,0 +1,323 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <thread>  // NOLINT [build/c++11]
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "SDL_helpers.hpp"
+#include "components/widget.hpp"
+
+/**
+ * Entity-component storage. Entities with the same set of components share an archetype, which keeps
+ * them in fixed size chunks with one contiguous array per component, so systems walk plain arrays.
+ */
+namespace ecs {
+    using ComponentId = Uint32;
+    using Signature   = Uint64;
+
+    constexpr std::size_t MAX_COMPONENTS = 64;
+
+    struct Entity {
+        Uint32 index;
+        Uint32 generation;
+
+        auto operator==(Entity const&) const -> bool = default;
+    };
+
+    /** How to size and relocate a component type without knowing it statically */
+    struct ComponentInfo {
+        std::size_t size;
+        std::size_t align;
+        void (*relocate)(void* destination, void* source);
+        void (*destroy)(void* component);
+    };
+
+    auto registerComponent(ComponentInfo const& info) -> ComponentId;
+    auto componentInfo(ComponentId id) -> ComponentInfo const&;
+
+    /** Ids are handed out on first use, so they're only stable within a run */
+    template<typename Component_T>
+    auto componentId() -> ComponentId {
+        using T = std::remove_cv_t<Component_T>;
+        static const auto id = registerComponent({
+            sizeof(T),
+            alignof(T),
+            [](void* destination, void* source) {
+                new (destination) T(std::move(*static_cast<T*>(source)));
+                static_cast<T*>(source)->~T();
+            },
+            [](void* component) { static_cast<T*>(component)->~T(); }
+        });
+        return id;
+    }
+
+    template<typename... Components_T>
+    auto signature() -> Signature {
+        return (Signature{0} | ... | (Signature{1} << componentId<Components_T>()));
+    }
+
+
+    /** All entities with exactly one signature, in chunks of structure-of-arrays storage */
+    class Archetype {
+     public:
+        static constexpr std::size_t CHUNK_BYTES = 16 * 1024;
+        static constexpr std::size_t CHUNK_ALIGN = 64;
+
+        struct Chunk {
+            struct Free { auto operator()(std::byte* memory) const -> void; };
+
+            std::unique_ptr<std::byte, Free> memory;
+            Uint32 count;
+        };
+
+        struct Location {
+            Uint32 chunk;
+            Uint32 row;
+        };
+
+     private:
+        Signature signature_;
+        std::vector<ComponentId> ids_;
+        std::vector<ComponentInfo> infos_;
+        std::array<Sint8, MAX_COMPONENTS> column_;
+        std::vector<std::size_t> offsets_;
+        std::size_t chunk_bytes_;
+        Uint32 capacity_;
+        std::vector<Chunk> chunks_;
+        std::size_t size_;
+
+     public:
+        explicit Archetype(Signature signature);
+        ~Archetype();
+
+        Archetype(Archetype const&)                    = delete;
+        auto operator=(Archetype const&) -> Archetype& = delete;
+
+        auto signature() const -> Signature;
+        auto size() const -> std::size_t;
+        auto capacity() const -> Uint32;
+        auto chunks() -> std::vector<Chunk>&;
+
+        auto entities(Chunk const& chunk) const -> Entity*;
+        auto column(Chunk const& chunk, ComponentId id) const -> void*;
+        auto at(Location const& location, ComponentId id) const -> void*;
+
+        /** Reserves a row at the end, components are left for the caller to construct */
+        auto allocate(Entity entity) -> Location;
+        /**
+         * Fills the row with the archetype's last entity and returns that entity so its record can be
+         * fixed up. Components in `relocated` have already been moved out and are not destroyed again.
+         */
+        auto release(Location const& location, Signature relocated) -> Entity;
+    };
+
+
+    /** Owns every entity and archetype. Structural changes must not happen while iterating. */
+    class World {
+     private:
+        struct Record {
+            Archetype* archetype;
+            Archetype::Location location;
+            Uint32 generation;
+        };
+
+        std::vector<std::unique_ptr<Archetype>> archetypes_;
+        std::unordered_map<Signature, Archetype*> by_signature_;
+        std::vector<Record> records_;
+        std::vector<Uint32> free_;
+        std::size_t size_;
+
+        auto archetype(Signature signature) -> Archetype*;
+        auto record(Entity entity) -> Record*;
+        auto record(Entity entity) const -> Record const*;
+        auto spawn(Signature signature) -> Entity;
+        auto migrate(Entity entity, Signature signature) -> void;
+
+        template<typename... Components_T, typename Function_T>
+        static auto visit(Function_T& fn, Archetype& archetype, Archetype::Chunk& chunk) -> void;
+
+     public:
+        World();
+
+        World(World const&)                    = delete;
+        auto operator=(World const&) -> World& = delete;
+
+        auto size() const -> std::size_t;
+        auto alive(Entity entity) const -> bool;
+        auto destroy(Entity entity) -> bool;
+
+        template<typename... Components_T>
+        auto create(Components_T&&... components) -> Entity;
+
+        template<typename Component_T>
+        auto has(Entity entity) const -> bool;
+        /** Returns nullptr if the entity is gone or doesn't have the component */
+        template<typename Component_T>
+        auto get(Entity entity) -> Component_T*;
+        /** Adds or replaces the component, moving the entity to its new archetype if needed */
+        template<typename Component_T>
+        auto add(Entity entity, Component_T&& component) -> std::remove_cvref_t<Component_T>*;
+        template<typename Component_T>
+        auto remove(Entity entity) -> bool;
+
+        /** Calls fn(count, Components_T*...) once per chunk holding all the requested components */
+        template<typename... Components_T, typename Function_T>
+        auto eachChunk(Function_T&& fn) -> void;
+        /** Calls fn(Components_T&...) once per entity holding all the requested components */
+        template<typename... Components_T, typename Function_T>
+        auto each(Function_T&& fn) -> void;
+        /** eachChunk() with the chunks shared out between worker threads; fn must be safe to call concurrently */
+        template<typename... Components_T, typename Function_T>
+        auto parallelEachChunk(unsigned workers, Function_T&& fn) -> void;
+    };
+
+
+    /** Position of an entity's top left corner */
+    struct Transform {
+        float  x;
+        float  y;
+        double angle;
+    };
+
+    /** The texture and its source clip come from the view, clip is where it lands relative to the transform */
+    struct Sprite {
+        TextureView texture;
+        SDL_Rect    clip;
+    };
+
+    /** Pointer target relative to the transform */
+    struct HitBox {
+        SDL_Rect rect;
+    };
+
+    /** widget::Flags bits */
+    struct UIState {
+        widget::State state;
+    };
+
+    auto renderSprites(World& world, SDL_Renderer* renderer) -> void;
+    auto updateUI(World& world, InputSnapshot const& input) -> void;
+
+
+    template<typename... Components_T>
+    auto World::create(Components_T&&... components) -> Entity {
+        auto entity   = spawn(signature<std::remove_cvref_t<Components_T>...>());
+        auto& entry   = records_[entity.index];
+        (new (entry.archetype->at(entry.location, componentId<std::remove_cvref_t<Components_T>>()))
+            std::remove_cvref_t<Components_T>(std::forward<Components_T>(components)), ...);
+        return entity;
+    }
+
+    template<typename Component_T>
+    auto World::has(Entity entity) const -> bool {
+        auto entry = record(entity);
+        return entry && (entry->archetype->signature() & signature<Component_T>());
+    }
+
+    template<typename Component_T>
+    auto World::get(Entity entity) -> Component_T* {
+        auto entry = record(entity);
+        if (!entry || !(entry->archetype->signature() & signature<Component_T>())) {
+            return nullptr;
+        }
+        return static_cast<Component_T*>(entry->archetype->at(entry->location, componentId<Component_T>()));
+    }
+
+    template<typename Component_T>
+    auto World::add(Entity entity, Component_T&& component) -> std::remove_cvref_t<Component_T>* {
+        using T = std::remove_cvref_t<Component_T>;
+
+        if (auto existing = get<T>(entity)) {
+            *existing = std::forward<Component_T>(component);
+            return existing;
+        }
+
+        auto entry = record(entity);
+        if (!entry) {
+            return nullptr;
+        }
+        migrate(entity, entry->archetype->signature() | signature<T>());
+        entry = record(entity);
+        return new (entry->archetype->at(entry->location, componentId<T>())) T(std::forward<Component_T>(component));
+    }
+
+    template<typename Component_T>
+    auto World::remove(Entity entity) -> bool {
+        if (!has<Component_T>(entity)) {
+            return false;
+        }
+        migrate(entity, record(entity)->archetype->signature() & ~signature<Component_T>());
+        return true;
+    }
+
+    template<typename... Components_T, typename Function_T>
+    auto World::visit(Function_T& fn, Archetype& archetype, Archetype::Chunk& chunk) -> void {
+        fn(chunk.count, static_cast<Components_T*>(archetype.column(chunk, componentId<Components_T>()))...);
+    }
+
+    template<typename... Components_T, typename Function_T>
+    auto World::eachChunk(Function_T&& fn) -> void {
+        auto mask = signature<Components_T...>();
+        for (auto& archetype : archetypes_) {
+            if ((archetype->signature() & mask) != mask) {
+                continue;
+            }
+            for (auto& chunk : archetype->chunks()) {
+                visit<Components_T...>(fn, *archetype, chunk);
+            }
+        }
+    }
+
+    template<typename... Components_T, typename Function_T>
+    auto World::each(Function_T&& fn) -> void {
+        eachChunk<Components_T...>([&fn](Uint32 count, Components_T*... columns) {
+            for (auto i = Uint32{0}; i < count; i++) {
+                fn(columns[i]...);
+            }
+        });
+    }
+
+    template<typename... Components_T, typename Function_T>
+    auto World::parallelEachChunk(unsigned workers, Function_T&& fn) -> void {
+        auto mask = signature<Components_T...>();
+        auto work = std::vector<std::pair<Archetype*, Archetype::Chunk*>>{};
+        for (auto& archetype : archetypes_) {
+            if ((archetype->signature() & mask) == mask) {
+                for (auto& chunk : archetype->chunks()) {
+                    work.emplace_back(archetype.get(), &chunk);
+                }
+            }
+        }
+
+        workers = std::max(1u, std::min(workers, static_cast<unsigned>(work.size())));
+        auto run = [&](std::size_t first, std::size_t last) {
+            for (auto i = first; i < last; i++) {
+                visit<Components_T...>(fn, *work[i].first, *work[i].second);
+            }
+        };
+
+        // Contiguous runs of chunks per worker, the calling thread takes the first one
+        auto threads = std::vector<std::thread>{};
+        auto share   = (work.size() + workers - 1) / workers;
+        for (auto w = 1u; w < workers; w++) {
+            auto first = std::min(work.size(), w * share);
+            auto last  = std::min(work.size(), first + share);
+            if (first < last) {
+                threads.emplace_back(run, first, last);
+            }
+        }
+        run(0, std::min(work.size(), share));
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+}  // namespace ecs
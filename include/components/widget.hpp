@@ -0,0 +1,104 @@
+#pragma once
+
+#include <vector>
+
+#include "SDL_helpers.hpp"
+
+/** The hover/click state machine every widget shares */
+namespace widget {
+    using State = Uint8;
+
+    enum Flags: State {
+        HOVERING = 1 << 0,
+        CLICKING = 1 << 1,
+        CLICKED  = 1 << 2,
+    };
+
+    /** Strictly inside the rect, the edges don't count. Evaluated without short circuits. */
+    inline auto inside(SDL_Rect const& rect, int x, int y) -> bool {
+        return (x > rect.x) & (x < rect.x + rect.w) & (y > rect.y) & (y < rect.y + rect.h);
+    }
+
+    /**
+     * Advances one widget by a frame:
+     *  - clicked when the button comes up over a widget that was being clicked
+     *  - clicking when pressed over a hovered widget, and held while dragged outside
+     *  - hovering while inside, unless the button was already down on entry
+     * Only bit arithmetic, so loops over it vectorise.
+     */
+    inline auto step(State state, bool inside, bool pressed) -> State {
+        auto i = static_cast<unsigned>(inside);
+        auto p = static_cast<unsigned>(pressed);
+        auto h = static_cast<unsigned>(state) & 1u;
+        auto c = (static_cast<unsigned>(state) >> 1) & 1u;
+
+        auto hovering = i & (h | ((p ^ 1u) & (c ^ 1u)));
+        auto clicking = p & ((i & h) | ((i ^ 1u) & c));
+        auto clicked  = i & (p ^ 1u) & c;
+        return static_cast<State>(hovering | (clicking << 1) | (clicked << 2));
+    }
+}
+
+/**
+ * Rects and states of many widgets in parallel arrays. update() advances all of them together in one
+ * pass; advance() steps a single widget for callers that have already narrowed down which ones to touch.
+ */
+class WidgetSet {
+ public:
+    using WidgetId = Uint32;
+
+ private:
+    std::vector<int> x_;
+    std::vector<int> y_;
+    std::vector<int> w_;
+    std::vector<int> h_;
+    std::vector<widget::State> state_;
+
+    auto step(int x, int y, bool pressed) -> bool;
+
+ public:
+    WidgetSet();
+
+    auto add(SDL_Rect const& rect, widget::State state=0) -> WidgetId;
+    auto clear() -> void;
+    auto size() const -> std::size_t;
+
+    auto rect(WidgetId id) const -> SDL_Rect;
+    auto setRect(WidgetId id, SDL_Rect const& rect) -> void;
+
+    auto state(WidgetId id)      const -> widget::State;
+    auto isHovering(WidgetId id) const -> bool;
+    auto isClicking(WidgetId id) const -> bool;
+    auto isClicked(WidgetId id)  const -> bool;
+
+    /** Returns true if the state changed */
+    auto advance(WidgetId id, bool inside, bool pressed) -> bool;
+
+    /** Both return true if any widget is left holding a click */
+    auto update() -> bool;
+    auto update(InputSnapshot const& input) -> bool;
+};
+
+
+/**
+ * Where a widget keeps its state: a slot in a WidgetSet once it has been attached to one, otherwise its
+ * own. Copies share the slot, so attach a widget once it has settled where it will live.
+ */
+class WidgetSlot {
+ private:
+    WidgetSet*          set_;
+    WidgetSet::WidgetId id_;
+    widget::State       state_;
+
+ public:
+    WidgetSlot();
+
+    auto attach(WidgetSet& set, SDL_Rect const& rect) -> void;
+    /** Takes the state back, and leaves an empty rect in the set that nothing can hit */
+    auto detach() -> void;
+
+    auto state() const -> widget::State;
+    auto advance(bool inside, bool pressed) -> bool;
+    /** Keeps the set's copy of the rect in step with the widget's */
+    auto setRect(SDL_Rect const& rect) -> void;
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+/** Time source for timers and frame loops. Everything that measures game time takes one of these. */
+class Clock {
+ public:
+    static auto real() -> Clock&;
+
+    virtual ~Clock() = default;
+
+    /** Current time in nanoseconds */
+    virtual auto nanos() -> Uint64 = 0;
+    /** Waits until nanos() reaches the target, or as near as the clock can coarsely get */
+    virtual auto sleepUntil(Uint64 target) -> void = 0;
+    /** True if sleepUntil can undershoot and callers should spin out the remainder */
+    virtual auto precise() const -> bool;
+    /** True while the clock is stopped, sleepUntil can't reach a later target and returns at once */
+    virtual auto paused() const -> bool;
+
+    /** Whole milliseconds of nanos() */
+    virtual auto ticks() -> Uint32;
+};
+
+/** Wall time from the high resolution performance counter */
+class RealClock: public Clock {
+ private:
+    Uint64 frequency_;
+    Uint64 base_;
+
+ public:
+    RealClock();
+
+    auto nanos() -> Uint64 override;
+    auto sleepUntil(Uint64 target) -> void override;
+    auto precise() const -> bool override;
+    auto ticks() -> Uint32 override;
+};
+
+/**
+ * Runs another clock faster or slower. A scale of zero pauses it. While input is recorded or replayed the
+ * parent is read through its ticks, so scaled time follows the recording at millisecond resolution.
+ */
+class ScaledClock: public Clock {
+ private:
+    Clock* parent_;
+    double scale_;
+    double resume_scale_;
+    bool   recorded_base_;
+    Uint64 parent_base_;
+    Uint64 base_;
+    Uint64 last_;
+
+    auto parentNanos() -> Uint64;
+    auto elapsed(Uint64 parent) const -> Uint64;
+
+ public:
+    explicit ScaledClock(Clock& parent=Clock::real(), double scale=1.0);
+
+    auto scale() const -> double;
+    /** Also true while the parent is paused */
+    auto paused() const -> bool override;
+
+    auto setScale(double scale) -> void;
+    auto pause()  -> void;
+    auto resume() -> void;
+
+    auto nanos() -> Uint64 override;
+    auto sleepUntil(Uint64 target) -> void override;
+    auto precise() const -> bool override;
+};
+
+/** Only moves when stepped. Sleeping jumps straight to the target, so paced loops run as fast as they can. */
+class ManualClock: public Clock {
+ private:
+    Uint64 now_;
+
+ public:
+    explicit ManualClock(Uint64 start=0);
+
+    auto set(Uint64 ns) -> void;
+    auto step(Uint64 ns) -> void;
+    auto stepMs(Uint32 ms) -> void;
+
+    auto nanos() -> Uint64 override;
+    auto sleepUntil(Uint64 target) -> void override;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "helpers/MotionCoalescer.hpp"
+
+/** Drains the event queue in batches and routes each event through a table indexed by event type */
+class EventDispatcher {
+ public:
+    using Handler = std::function<void(SDL_Event const&)>;
+    using HandlerId = Uint32;
+
+ private:
+    static constexpr int BATCH_SIZE = 64;
+
+    struct Entry {
+        HandlerId id;
+        Handler   handler;
+        bool      frame_only;
+        bool      removed;
+    };
+
+    using HandlerList = std::vector<Entry>;
+    using Page        = std::array<HandlerList, 256>;
+
+    // Two level table over the 16 bit event type space, pages are allocated on first subscription
+    std::array<std::unique_ptr<Page>, 256> table_;
+    std::unordered_map<SDL_Keycode, HandlerList> keys_;
+    HandlerList any_;
+
+    std::unordered_map<HandlerId, HandlerList*> owners_;
+    std::vector<std::pair<HandlerList*, Entry>> pending_;
+    std::array<SDL_Event, BATCH_SIZE> batch_;
+    MotionCoalescer motion_;
+
+    HandlerId next_id_;
+    bool dispatching_;
+    bool removed_;
+    bool frame_subscriptions_;
+    bool coalesce_motion_;
+
+    auto list(Uint32 type) -> HandlerList&;
+    auto find(Uint32 type) const -> HandlerList const*;
+    auto add(HandlerList& list, Handler&& handler, bool frame_only) -> HandlerId;
+    auto invoke(HandlerList& list, SDL_Event const& event) -> void;
+    auto flush(bool end_of_frame) -> void;
+    auto deliver(SDL_Event const& event) -> void;
+
+ public:
+    EventDispatcher();
+
+    auto on(Uint32 type, Handler handler)          -> HandlerId;
+    auto onKey(SDL_Keycode key, Handler handler)   -> HandlerId;
+    auto onAny(Handler handler)                    -> HandlerId;
+    auto onFrame(Uint32 type, Handler handler)     -> HandlerId;
+    auto off(HandlerId id) -> bool;
+
+    /** Merges each run of mouse motion within a dispatch into a single event. Off by default. */
+    auto coalesceMotion(bool enabled, bool keep_path=true) -> void;
+    /** Every motion event seen by the last dispatch, including the ones that were merged away */
+    auto motionPath() const -> std::vector<SDL_MouseMotionEvent> const&;
+
+    auto route(SDL_Event const& event) -> void;
+    auto dispatch() -> int;
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Bump allocator for data that only lives for one frame. Deallocation is a no-op and reset() rewinds
+ * everything at once. If a frame overflows the block it takes more from the upstream heap, and the next
+ * reset() folds them into one block big enough for the peak, so a steady frame loop stops allocating.
+ */
+class FrameArena: public std::pmr::memory_resource {
+ private:
+    struct Block {
+        std::byte*  data;
+        std::size_t size;
+    };
+
+    std::vector<Block> blocks_;
+    std::size_t offset_;
+    std::size_t used_;
+    std::size_t peak_;
+    Uint64      upstream_;
+    Uint64      frame_upstream_;
+
+    auto grow(std::size_t bytes, std::size_t alignment) -> void;
+    auto freeBlocks() -> void;
+
+ protected:
+    auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override;
+    auto do_deallocate(void* p, std::size_t bytes, std::size_t alignment) -> void override;
+    auto do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool override;
+
+ public:
+    explicit FrameArena(std::size_t capacity=64*1024);
+    ~FrameArena() override;
+
+    FrameArena(FrameArena const&)                    = delete;
+    auto operator=(FrameArena const&) -> FrameArena& = delete;
+
+    /** Call once per frame after the last use of the previous frame's data. Returns that frame's upstream allocations. */
+    auto reset() -> Uint64;
+
+    auto used()     const -> std::size_t;
+    auto capacity() const -> std::size_t;
+    /** Most bytes any frame has used */
+    auto peak()     const -> std::size_t;
+    /** Blocks taken from the heap since construction; flat once the loop has settled */
+    auto upstreamAllocations() const -> Uint64;
+
+    template<typename T>
+    auto vector() -> std::pmr::vector<T> { return std::pmr::vector<T>{this}; }
+    auto string() -> std::pmr::string { return std::pmr::string{this}; }
+
+    /** printf into the arena. The view is null terminated and valid until the next reset(). */
+    auto format(char const* fmt, ...) -> std::string_view __attribute__((format(printf, 2, 3)));
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include "Clock.hpp"
+
+/** Paces a frame loop to an exact period using a coarse sleep followed by a short spin */
+class FramePacer {
+ private:
+    Clock* clock_;
+    Uint64 period_ns_;
+    Uint64 spin_ns_;
+    Uint64 base_spin_ns_;
+    Uint64 oversleep_ns_;
+    Uint64 deadline_;
+    Uint64 last_wake_;
+    Uint64 frame_time_;
+    Uint64 missed_;
+    bool   missed_last_;
+
+ public:
+    static auto now() -> Uint64;
+
+    explicit FramePacer(Uint64 period_ns, Uint64 spin_ns=2'000'000, Clock& clock=Clock::real());
+    FramePacer(Uint64 period_ns, Clock& clock);
+
+    auto clock() -> Clock&;
+
+    auto period()     const -> Uint64;
+    auto spin()       const -> Uint64;
+    auto frameTime()  const -> Uint64;
+    auto missed()     const -> Uint64;
+    auto missedLast() const -> bool;
+
+    auto setPeriod(Uint64 period_ns) -> void;
+
+    auto wait()  -> bool;
+    auto reset() -> void;
+};
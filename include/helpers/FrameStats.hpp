@@ -0,0 +1,60 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <vector>
+#include <cstddef>
+
+/** Nanosecond timings for one frame */
+struct FrameSample {
+    Uint64 cpu;
+    Uint64 present;
+    Uint64 total;
+};
+
+/** Distribution of one timing channel over the sampled window */
+struct FrameSummary {
+    Uint64 min;
+    Uint64 mean;
+    Uint64 p50;
+    Uint64 p95;
+    Uint64 p99;
+    Uint64 max;
+};
+
+/** Records per-frame timings into a ring buffer and reports statistics over the most recent frames */
+class FrameStats {
+ private:
+    std::vector<FrameSample> samples_;
+    mutable std::vector<Uint64> scratch_;
+    std::size_t next_;
+    std::size_t count_;
+
+    Uint64 frame_begin_;
+    Uint64 present_begin_;
+    FrameSample current_;
+    bool in_frame_;
+
+    auto summarize(Uint64 FrameSample::* channel) const -> FrameSummary;
+
+ public:
+    explicit FrameStats(std::size_t window=600);
+
+    auto window() const -> std::size_t;
+    auto size()   const -> std::size_t;
+    auto sample(std::size_t age) const -> FrameSample const&;
+
+    auto beginFrame()   -> void;
+    auto beginPresent() -> void;
+    auto endPresent()   -> void;
+    auto record(FrameSample const& sample) -> void;
+    auto clear() -> void;
+
+    auto cpu()     const -> FrameSummary;
+    auto present() const -> FrameSummary;
+    auto total()   const -> FrameSummary;
+
+    auto histogram(Uint64 bucket_ns, std::size_t buckets) const -> std::vector<std::size_t>;
+
+    auto dump(char const* file_name) const -> bool;
+};
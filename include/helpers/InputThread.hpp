@@ -0,0 +1,73 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <atomic>
+#include <chrono>  // NOLINT [build/c++11]
+#include <deque>
+#include <mutex>   // NOLINT [build/c++11]
+#include <thread>  // NOLINT [build/c++11]
+
+#include "helpers/SpscQueue.hpp"
+
+/** An event along with the performance counter value at the moment it was pumped */
+struct TimedEvent {
+    SDL_Event event;
+    Uint64    counter;
+};
+
+/**
+ * Takes events off SDL's queue the moment they're pumped, stamps them with the performance counter, and
+ * hands them to the simulation through a lock free ring. Under the dummy video driver a background thread
+ * pumps continuously. Everywhere else pumping has to stay on the main thread, so a stamp is only as fine
+ * as the pumps: with one a frame every event lands on the frame, and each extra pump() narrows that.
+ */
+class InputThread {
+ public:
+    static constexpr size_t CAPACITY = 1024;
+
+ private:
+    SpscQueue<TimedEvent, CAPACITY> queue_;
+
+    std::thread               pump_;
+    std::atomic<bool>         running_;
+    std::atomic<SDL_threadID> producer_;
+
+    // Events from other threads, or that don't fit, go here and everything after them follows until it drains
+    std::mutex                spill_mutex_;
+    std::deque<TimedEvent>    spilled_;
+    std::atomic<bool>         spilling_;
+
+    std::chrono::microseconds interval_;
+    SDL_EventFilter           previous_filter_;
+    void*                     previous_userdata_;
+    bool                      started_;
+    bool                      threaded_;
+
+    static auto filter(void* userdata, SDL_Event* event) -> int;
+
+    auto takeSpilled(TimedEvent* out, Uint64 until=~Uint64{0}) -> bool;
+
+ public:
+    explicit InputThread(std::chrono::microseconds interval=std::chrono::microseconds{500});
+    ~InputThread();
+
+    InputThread(InputThread const&)                    = delete;
+    auto operator=(InputThread const&) -> InputThread& = delete;
+
+    /** SDL only allows pumping on the thread that created the window, so this is just the dummy driver */
+    static auto threadingSupported() -> bool;
+
+    auto start(bool threaded=true) -> bool;
+    auto stop() -> void;
+
+    auto threaded() const -> bool;
+
+    /** Pumps SDL on the calling thread. Only needed when not threaded; call it as often as is convenient. */
+    auto pump() -> void;
+
+    /** Takes the next event. Returns false once nothing is waiting. */
+    auto poll(TimedEvent* out) -> bool;
+    /** Takes the next event only if it arrived at or before the given performance counter value */
+    auto pollUntil(Uint64 counter, TimedEvent* out) -> bool;
+};
@@ -8,6 +8,8 @@
 #include <memory>
 #include <utility>
 
+#include "inventory.hpp"
+
 template<typename T>
 static void nothing(T*) {}
 
@@ -18,15 +20,23 @@ struct ManagedResource {
 
     resource_ptr resource_;
 
+    /** Takes the resource off the inventory before freeing it */
+    static auto destroy(Resource* resource) -> void {
+        if (resource) {
+            inventory::remove(resource);
+            freeResource(resource);
+        }
+    }
+
     ManagedResource(): resource_(nullptr,  nothing<Resource>) {}
 
-    explicit ManagedResource(Resource* resource): resource_(resource, freeResource) {}
+    explicit ManagedResource(Resource* resource): resource_(inventory::track(resource, {}), destroy) {}
 
     template<typename ManagedResource_T>
     explicit ManagedResource(ManagedResource_T&&  other): resource_(other.resource_) {}
 
     auto operator=(Resource* resource) -> ManagedResource& {
-        resource_ = resource_ptr{resource, freeResource};
+        resource_ = resource_ptr{inventory::track(resource, {}), destroy};
         return *this;
     };
 
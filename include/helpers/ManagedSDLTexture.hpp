@@ -10,9 +10,11 @@
 #include <optional>
 
 #include "ManagedResource.hpp"
+#include "TextureView.hpp"
+#include "residency.hpp"
 
 
-struct ManagedSDLTexture: public ManagedResource<SDL_Texture, SDL_DestroyTexture> {
+struct ManagedSDLTexture: public ManagedResource<SDL_Texture, residency::destroyTexture> {
     SDL_Rect src_clip_;
 
     ManagedSDLTexture();
@@ -32,6 +34,10 @@ struct ManagedSDLTexture: public ManagedResource<SDL_Texture, SDL_DestroyTexture
     auto pos()  const -> SDL_Point;
     auto dim()  const -> SDL_Point;
 
+    /** Non-owning views for sprite tables and hot paths; this texture has to outlive them */
+    auto view() const -> TextureView;
+    auto view(SDL_Rect const& source_clip) const -> TextureView;
+
     auto setClip(SDL_Rect const&)     -> ManagedSDLTexture&;
     auto setClipPos(SDL_Point const&) -> ManagedSDLTexture&;
     auto setClipDim(SDL_Point const&) -> ManagedSDLTexture&;
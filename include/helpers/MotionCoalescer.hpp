@@ -0,0 +1,65 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <utility>
+#include <vector>
+
+/**
+ * Merges runs of consecutive mouse motion events into one, so a 1000 Hz mouse costs a single handler
+ * call per frame. The merged event carries the latest position and the summed relative motion. Any
+ * other event, or a change of window, mouse or button state, ends the run so ordering is preserved.
+ */
+class MotionCoalescer {
+ private:
+    SDL_Event pending_;
+    bool      has_pending_;
+    bool      keep_path_;
+    int       merged_;
+    std::vector<SDL_MouseMotionEvent> path_;
+
+    /** Folds the event into the pending run, returns false if it has to start a new one */
+    auto merge(SDL_MouseMotionEvent const& motion) -> bool;
+
+ public:
+    explicit MotionCoalescer(bool keep_path=true);
+
+    /** Starts a new frame's path. Call once per frame before feeding. */
+    auto beginFrame() -> void;
+
+    /** Every raw motion event fed in since beginFrame(), if the path is being kept */
+    auto path() const -> std::vector<SDL_MouseMotionEvent> const&;
+    /** Number of motion events absorbed into others since beginFrame() */
+    auto merged() const -> int;
+
+    auto keepPath(bool keep) -> void;
+
+    /** Passes the event through deliver, holding back motion until its run ends */
+    template <typename Deliver>
+    auto feed(SDL_Event const& event, Deliver&& deliver) -> void {
+        if (event.type == SDL_MOUSEMOTION) {
+            if (keep_path_) {
+                path_.push_back(event.motion);
+            }
+            if (has_pending_ && merge(event.motion)) {
+                return;
+            }
+            flush(deliver);
+            pending_     = event;
+            has_pending_ = true;
+            return;
+        }
+
+        flush(deliver);
+        deliver(event);
+    }
+
+    /** Delivers the held motion event, if any. Call after the last event of a frame. */
+    template <typename Deliver>
+    auto flush(Deliver&& deliver) -> void {
+        if (has_pending_) {
+            has_pending_ = false;
+            deliver(std::as_const(pending_));
+        }
+    }
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+namespace profiler {
+    /** Zone names must outlive the profiler, in practice they are string literals */
+    auto record(char const* name, Uint64 begin, Uint64 end) -> void;
+    auto exportChromeTrace(char const* file_name) -> bool;
+    auto clear() -> void;
+
+    /** Records the time between construction and destruction as a zone on the calling thread */
+    class Zone {
+     private:
+        char const* name_;
+        Uint64 begin_;
+
+     public:
+        explicit Zone(char const* name);
+        ~Zone();
+
+        Zone(Zone const&) = delete;
+        auto operator=(Zone const&) -> Zone& = delete;
+    };
+}
+
+#define PROFILER_CONCAT_IMPL(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_IMPL(a, b)
+
+#ifdef PROFILING
+    #define PROFILE_ZONE(name) profiler::Zone PROFILER_CONCAT(profile_zone_, __LINE__){name}
+    #define PROFILE_FUNCTION() PROFILE_ZONE(__func__)
+#else
+    #define PROFILE_ZONE(name) static_cast<void>(0)
+    #define PROFILE_FUNCTION() static_cast<void>(0)
+#endif
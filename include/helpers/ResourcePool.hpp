@@ -0,0 +1,186 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_ttf.h>
+#include <SDL2/SDL_mixer.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "inventory.hpp"
+#include "residency.hpp"
+
+/**
+ * 32 bit reference into a ResourcePool, the low 20 bits are the slot and the high 12 bits the slot's
+ * generation when the handle was made. Zero is never a live handle.
+ */
+template<typename Resource>
+struct Handle {
+    static constexpr Uint32 INDEX_BITS      = 20;
+    static constexpr Uint32 INDEX_MASK      = (1u << INDEX_BITS) - 1;
+    static constexpr Uint32 GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;
+
+    Uint32 bits;
+
+    auto index()      const -> Uint32 { return bits & INDEX_MASK; }
+    auto generation() const -> Uint32 { return bits >> INDEX_BITS; }
+
+    explicit operator bool() const { return bits != 0; }
+    auto operator==(Handle const&) const -> bool = default;
+};
+
+
+/** Owns resources of one type in a dense slot array and hands out generational handles to them */
+template<typename Resource, void (*freeResource)(Resource*)>
+class ResourcePool {
+ public:
+    using handle_type = Handle<Resource>;
+
+ private:
+    std::vector<Resource*> resources_;
+    std::vector<Uint32>    generations_;
+    std::vector<Uint32>    free_;
+    std::size_t            live_;
+
+ public:
+    ResourcePool(): resources_(), generations_(), free_(), live_(0) {}
+    ~ResourcePool() { clear(); }
+
+    ResourcePool(ResourcePool const&)                    = delete;
+    auto operator=(ResourcePool const&) -> ResourcePool& = delete;
+
+    /** Takes ownership. A null resource gives a null handle, so failed loads can be checked either way. */
+    auto acquire(Resource* resource) -> handle_type {
+        if (!resource) {
+            return {0};
+        }
+
+        auto index = Uint32{0};
+        if (!free_.empty()) {
+            index = free_.back();
+            free_.pop_back();
+        } else {
+            index = static_cast<Uint32>(resources_.size());
+            if (index > handle_type::INDEX_MASK) {
+                std::cout << "Resource pool is full.\n";
+                freeResource(resource);
+                return {0};
+            }
+            resources_.push_back(nullptr);
+            generations_.push_back(1);
+        }
+
+        resources_[index] = inventory::track(resource, {});
+        live_++;
+        return {(generations_[index] << handle_type::INDEX_BITS) | index};
+    }
+
+    /** Frees the resource now. Every handle to it goes stale, returns false if it already was. */
+    auto release(handle_type handle) -> bool {
+        if (!alive(handle)) {
+            return false;
+        }
+
+        auto index = handle.index();
+        inventory::remove(resources_[index]);
+        freeResource(resources_[index]);
+        resources_[index] = nullptr;
+
+        // Generation zero is skipped on wrap so a live handle can never be all zeroes
+        generations_[index] = (generations_[index] + 1) & handle_type::GENERATION_MASK;
+        if (generations_[index] == 0) {
+            generations_[index] = 1;
+        }
+        free_.push_back(index);
+        live_--;
+        return true;
+    }
+
+    auto alive(handle_type handle) const -> bool {
+        auto index = handle.index();
+        return handle && index < resources_.size() && generations_[index] == handle.generation() && resources_[index];
+    }
+
+    /** Debug builds stop on a stale handle; release builds skip the check and may return null or a reused slot */
+    auto get(handle_type handle) const -> Resource* {
+#ifdef DEBUG
+        if (handle && !alive(handle)) {
+            std::cout << "Stale resource handle: slot " << handle.index() << " generation " << handle.generation() << std::endl;
+            std::abort();
+        }
+#endif
+        return handle ? resources_[handle.index()] : nullptr;
+    }
+
+    auto operator[](handle_type handle) const -> Resource* { return get(handle); }
+
+    auto size() const -> std::size_t { return live_; }
+
+    auto clear() -> void {
+        for (auto index = std::size_t{0}; index < resources_.size(); index++) {
+            if (resources_[index]) {
+                release({(generations_[index] << handle_type::INDEX_BITS) | static_cast<Uint32>(index)});
+            }
+        }
+    }
+};
+
+
+/** Releases its handle when it goes out of scope. Move only; copy the plain handle for non-owning references. */
+template<typename Pool_T>
+class ScopedHandle {
+ public:
+    using handle_type = typename Pool_T::handle_type;
+
+ private:
+    Pool_T*     pool_;
+    handle_type handle_;
+
+ public:
+    ScopedHandle(): pool_(nullptr), handle_{0} {}
+    ScopedHandle(Pool_T& pool, handle_type handle): pool_(&pool), handle_(handle) {}
+    ~ScopedHandle() { reset(); }
+
+    ScopedHandle(ScopedHandle const&)                    = delete;
+    auto operator=(ScopedHandle const&) -> ScopedHandle& = delete;
+
+    ScopedHandle(ScopedHandle&& other): pool_(other.pool_), handle_(std::exchange(other.handle_, handle_type{0})) {}
+
+    auto operator=(ScopedHandle&& other) -> ScopedHandle& {
+        if (this != &other) {
+            reset();
+            pool_   = other.pool_;
+            handle_ = std::exchange(other.handle_, handle_type{0});
+        }
+        return *this;
+    }
+
+    auto get() const -> handle_type { return handle_; }
+    operator handle_type() const { return handle_; }
+
+    auto reset() -> void {
+        if (pool_ && handle_) {
+            pool_->release(handle_);
+        }
+        handle_ = {0};
+    }
+};
+
+
+using TextureHandle = Handle<SDL_Texture>;
+using SurfaceHandle = Handle<SDL_Surface>;
+using FontHandle    = Handle<TTF_Font>;
+using ChunkHandle   = Handle<Mix_Chunk>;
+using MusicHandle   = Handle<Mix_Music>;
+
+/** One pool per resource type. Declare it after the renderer so textures are freed first. */
+struct ResourceRegistry {
+    ResourcePool<SDL_Texture, residency::destroyTexture> textures;
+    ResourcePool<SDL_Surface, SDL_FreeSurface>           surfaces;
+    ResourcePool<TTF_Font,    TTF_CloseFont>             fonts;
+    ResourcePool<Mix_Chunk,   Mix_FreeChunk>             chunks;
+    ResourcePool<Mix_Music,   Mix_FreeMusic>             music;
+};
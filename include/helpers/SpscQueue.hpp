@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/** Fixed capacity ring for exactly one producer thread and one consumer thread. Neither side ever blocks. */
+template <typename T, size_t N>
+class SpscQueue {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+ private:
+    static constexpr size_t MASK       = N - 1;
+    static constexpr size_t CACHE_LINE = 64;
+
+    // Each index lives on its own line so the two threads don't bounce a shared line on every push and pop
+    alignas(CACHE_LINE) std::atomic<size_t> head_;
+    alignas(CACHE_LINE) size_t              cached_tail_;
+    alignas(CACHE_LINE) std::atomic<size_t> tail_;
+    alignas(CACHE_LINE) size_t              cached_head_;
+    std::array<T, N> items_;
+
+ public:
+    SpscQueue(): head_(0), cached_tail_(0), tail_(0), cached_head_(0), items_() {}
+
+    SpscQueue(SpscQueue const&)                    = delete;
+    auto operator=(SpscQueue const&) -> SpscQueue& = delete;
+
+    static constexpr auto capacity() -> size_t { return N; }
+
+    /** Producer side. Returns false if the ring is full. */
+    auto push(T const& item) -> bool {
+        auto tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ == N) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ == N) {
+                return false;
+            }
+        }
+        items_[tail & MASK] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Consumer side. Returns the oldest item without removing it, or nullptr if empty. */
+    auto front() -> T* {
+        auto head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return nullptr;
+            }
+        }
+        return &items_[head & MASK];
+    }
+
+    /** Consumer side. Removes the item returned by front(). */
+    auto pop() -> void {
+        head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /** Consumer side. Returns false if the ring is empty. */
+    auto pop(T* out) -> bool {
+        auto item = front();
+        if (!item) {
+            return false;
+        }
+        *out = *item;
+        pop();
+        return true;
+    }
+
+    /** Approximate when called while the other side is running */
+    auto size() const -> size_t {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    auto empty() const -> bool { return size() == 0; }
+};
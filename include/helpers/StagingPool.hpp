@@ -0,0 +1,78 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "ManagedResource.hpp"
+#include "ManagedSDLTexture.hpp"
+
+/**
+ * Recycles the conversion surfaces and streaming textures behind text and image uploads. Both are
+ * bucketed by format and power of two size class; a source is converted into a pooled surface when its
+ * format differs, then copied into a pooled texture with SDL_UpdateTexture. The returned texture is
+ * clipped to the source's size and goes back to the pool when its last copy is dropped.
+ *
+ * All textures are made for the renderer passed to the first upload.
+ */
+class StagingPool {
+ public:
+    struct Stats {
+        Uint64 uploads;
+        Uint64 surfaces_created;
+        Uint64 textures_created;
+        Uint64 textures_reused;
+    };
+
+ private:
+    struct Key {
+        Uint32 format;
+        int    w;
+        int    h;
+
+        auto operator==(Key const&) const -> bool = default;
+    };
+
+    struct KeyHash {
+        auto operator()(Key const& key) const -> std::size_t;
+    };
+
+    /** Shared with the textures handed out, so one outliving the pool is just destroyed */
+    struct State {
+        std::unordered_map<Key, std::vector<SDL_Surface*>, KeyHash> surfaces;
+        std::unordered_map<Key, std::vector<SDL_Texture*>, KeyHash> textures;
+        Stats stats;
+
+        ~State();
+    };
+
+    std::shared_ptr<State> state_;
+    Uint32 format_;
+
+    static auto sizeClass(int size) -> int;
+
+    auto acquireSurface(Key const& key) -> SDL_Surface*;
+    auto acquireTexture(SDL_Renderer* renderer, Key const& key) -> SDL_Texture*;
+
+ public:
+    StagingPool();
+    explicit StagingPool(Uint32 format);
+
+    StagingPool(StagingPool const&)                    = delete;
+    auto operator=(StagingPool const&) -> StagingPool& = delete;
+
+    /** Copies the surface into a pooled texture, the surface still belongs to the caller */
+    auto upload(ManagedSDLRenderer& renderer, SDL_Surface* source) -> ManagedSDLTexture;
+
+    /** Same output as loadTextureFromText and loadTextureFromFile, without a new texture per call */
+    auto text(ManagedSDLRenderer& renderer, char const* string_to_render, ManagedTTFFont& font,
+              SDL_Colour const& colour={0, 0, 0, 0xff}) -> ManagedSDLTexture;
+    auto image(ManagedSDLRenderer& renderer, char const* image_name, std::optional<SDL_Colour> color_key={}) -> ManagedSDLTexture;
+
+    auto stats() const -> Stats;
+};
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <coroutine>
+#include <exception>
+#include <unordered_map>
+
+#include "TimerWheel.hpp"
+
+class Scheduler;
+class WaitList;
+
+/** Fire-and-forget coroutine. It runs until its first co_await and frees itself when it returns. */
+struct Task {
+    struct promise_type {
+        auto get_return_object() -> Task { return {}; }
+        auto initial_suspend() noexcept -> std::suspend_never { return {}; }
+        auto final_suspend()   noexcept -> std::suspend_never { return {}; }
+        auto return_void() -> void {}
+        auto unhandled_exception() -> void { std::terminate(); }
+    };
+};
+
+/** A suspended coroutine, linked into exactly one WaitList. Lives in the coroutine frame for the length of the co_await. */
+class Waiter {
+ private:
+    friend class WaitList;
+    friend class Scheduler;
+
+    std::coroutine_handle<> handle_;
+    Waiter*   prev_;
+    Waiter*   next_;
+    WaitList* list_;
+
+ public:
+    Waiter();
+    ~Waiter();
+
+    Waiter(Waiter const&) = delete;
+    auto operator=(Waiter const&) -> Waiter& = delete;
+};
+
+/** Intrusive list of suspended coroutines, suspending and resuming never allocates */
+class WaitList {
+ private:
+    friend class Scheduler;
+
+    Waiter* head_;
+
+ public:
+    WaitList();
+    ~WaitList();
+
+    WaitList(WaitList const&) = delete;
+    auto operator=(WaitList const&) -> WaitList& = delete;
+
+    auto empty() const -> bool;
+
+    auto push(Waiter& waiter, std::coroutine_handle<> handle) -> void;
+    auto remove(Waiter& waiter) -> void;
+    auto resumeAll() -> void;
+    auto destroyAll() -> void;
+};
+
+/** Signalled once by whoever finishes loading an asset, resumes every coroutine awaiting it. Main thread only. */
+class Completion {
+ private:
+    bool done_;
+    WaitList waiters_;
+
+ public:
+    struct Awaiter: Waiter {
+        Completion& completion;
+
+        explicit Awaiter(Completion& c): completion(c) {}
+
+        auto await_ready() const -> bool { return completion.done_; }
+        auto await_suspend(std::coroutine_handle<> handle) -> void { completion.waiters_.push(*this, handle); }
+        auto await_resume() const -> void {}
+    };
+
+    Completion();
+
+    auto done() const -> bool;
+    auto complete() -> void;
+    auto reset() -> void;
+
+    auto operator co_await() -> Awaiter;
+};
+
+/** Resumes coroutines from the frame loop. Suspended coroutines are destroyed along with the scheduler. */
+class Scheduler {
+ private:
+    TimerWheel timers_;
+    WaitList next_frame_;
+    WaitList sleeping_;
+    std::unordered_map<Uint32, WaitList> events_;
+
+ public:
+    struct FrameAwaiter: Waiter {
+        Scheduler& scheduler;
+
+        explicit FrameAwaiter(Scheduler& s): scheduler(s) {}
+
+        auto await_ready() const -> bool { return false; }
+        auto await_suspend(std::coroutine_handle<> handle) -> void { scheduler.next_frame_.push(*this, handle); }
+        auto await_resume() const -> void {}
+    };
+
+    struct DelayAwaiter: Waiter {
+        Scheduler& scheduler;
+        Uint32 delay;
+
+        DelayAwaiter(Scheduler& s, Uint32 ms): scheduler(s), delay(ms) {}
+
+        auto await_ready() const -> bool { return delay == 0; }
+        auto await_suspend(std::coroutine_handle<> handle) -> void;
+        auto await_resume() const -> void {}
+    };
+
+    struct EventAwaiter: Waiter {
+        Scheduler& scheduler;
+        Uint32 type;
+        SDL_Event event;
+
+        EventAwaiter(Scheduler& s, Uint32 event_type): scheduler(s), type(event_type), event() {}
+
+        auto await_ready() const -> bool { return false; }
+        auto await_suspend(std::coroutine_handle<> handle) -> void { scheduler.events_[type].push(*this, handle); }
+        auto await_resume() const -> SDL_Event { return event; }
+    };
+
+    Scheduler();
+    explicit Scheduler(Clock& clock);
+    explicit Scheduler(Uint32 start_ticks);
+    ~Scheduler();
+
+    Scheduler(Scheduler const&) = delete;
+    auto operator=(Scheduler const&) -> Scheduler& = delete;
+
+    auto timers() -> TimerWheel&;
+
+    auto nextFrame()               -> FrameAwaiter;
+    auto delay(Uint32 ms)          -> DelayAwaiter;
+    auto event(Uint32 event_type)  -> EventAwaiter;
+    auto loaded(Completion& asset) -> Completion::Awaiter;
+
+    auto dispatch(SDL_Event const& event) -> void;
+    auto frame(Uint32 ticks) -> void;
+    auto frame() -> void;
+};
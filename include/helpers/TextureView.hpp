@@ -0,0 +1,46 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <optional>
+#include <type_traits>
+
+
+/**
+ * Non-owning view of a clip of a texture. It's three plain fields, so copying one into a sprite table or
+ * passing it by value costs no refcount traffic; whatever made the texture (an atlas, a sheet, a pool)
+ * has to outlive every view of it.
+ */
+struct TextureView {
+    SDL_Texture* texture_;
+    SDL_Rect     src_clip_;
+    SDL_Point    base_dim_;
+
+    TextureView();
+    explicit TextureView(SDL_Texture* sdl_texture, std::optional<SDL_Rect> source_clip={});
+
+    explicit operator bool() const { return texture_ != nullptr; }
+    auto texture() const -> SDL_Texture* { return texture_; }
+
+    /** Size of the whole texture, cached when the view was made */
+    auto baseDim() const -> SDL_Point;
+
+    auto rect() const -> SDL_Rect const&;
+    auto pos()  const -> SDL_Point;
+    auto dim()  const -> SDL_Point;
+
+    /** View of a clip relative to this one, for picking frames out of a sub-sheet */
+    auto sub(SDL_Rect const& clip) const -> TextureView;
+
+    auto setClip(SDL_Rect const&)     -> TextureView&;
+    auto setClipPos(SDL_Point const&) -> TextureView&;
+    auto setClipDim(SDL_Point const&) -> TextureView&;
+
+    auto render(SDL_Renderer* renderer, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip) const -> void;
+    auto render(SDL_Renderer* renderer, SDL_Rect* clip, double angle, SDL_Point* center) const -> void;
+    auto render(SDL_Renderer* renderer, SDL_Rect* clip, SDL_RendererFlip flip) const -> void;
+    auto render(SDL_Renderer* renderer, SDL_Rect* clip) const -> void;
+    auto render(SDL_Renderer* renderer) const -> void;
+};
+
+static_assert(std::is_trivially_copyable_v<TextureView>);
@@ -5,8 +5,11 @@
 #include <optional>
 #include <algorithm>
 
+#include "Clock.hpp"
+
 class Timer {
  private:
+    Clock* clock_;
     Uint32 time_;
     Uint32 stop_time_;
     Uint32 begin_time_;
@@ -24,6 +27,10 @@ class Timer {
 
     Timer();
     explicit Timer(Uint32 duration);
+    explicit Timer(Clock& clock);
+    Timer(Uint32 duration, Clock& clock);
+
+    auto clock() -> Clock&;
 
     auto pause()    -> void;
     auto unpause()  -> void;
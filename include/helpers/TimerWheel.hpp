@@ -0,0 +1,93 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <array>
+#include <deque>
+#include <functional>
+#include <vector>
+
+#include "Clock.hpp"
+
+/** Identifies a timer scheduled on a TimerWheel. Stale handles are ignored by the wheel. */
+struct TimerHandle {
+    Uint32 index;
+    Uint32 generation;
+};
+
+/**
+ * Hierarchical timing wheel with millisecond ticks. Scheduling, cancelling and pausing are O(1), and
+ * advancing costs one slot visit per elapsed tick plus an occasional cascade, independent of timer count.
+ */
+class TimerWheel {
+ public:
+    using Callback = std::function<void()>;
+
+ private:
+    static constexpr int    LEVEL0_BITS  = 8;
+    static constexpr int    LEVELN_BITS  = 6;
+    static constexpr int    LEVELS       = 4;
+    static constexpr Uint32 LEVEL0_SLOTS = 1u << LEVEL0_BITS;
+    static constexpr Uint32 LEVELN_SLOTS = 1u << LEVELN_BITS;
+    static constexpr Uint32 TOTAL_SLOTS  = LEVEL0_SLOTS + (LEVELS-1) * LEVELN_SLOTS;
+    static constexpr Uint32 PENDING_SLOT = TOTAL_SLOTS;
+    static constexpr Uint32 MAX_DELAY    = (1u << (LEVEL0_BITS + (LEVELS-1) * LEVELN_BITS)) - 1;
+    static constexpr Uint32 NONE         = 0xFFFFFFFF;
+
+    struct Node {
+        Callback callback;
+        Uint32   expires;
+        Uint32   period;
+        Uint32   remaining;
+        Uint32   generation;
+        Uint32   prev;
+        Uint32   next;
+        Uint32   slot;
+        bool     active;
+        bool     paused;
+    };
+
+    // A deque keeps callbacks in place while a running callback schedules new timers
+    std::deque<Node>    nodes_;
+    std::vector<Uint32> free_;
+    std::array<Uint32, TOTAL_SLOTS + 1> heads_;
+
+    Clock* clock_;
+    Uint32 now_;
+    Uint32 firing_;
+    std::size_t size_;
+
+    auto node(TimerHandle handle) -> Node*;
+    auto node(TimerHandle handle) const -> Node const*;
+
+    auto schedule(Callback&& callback, Uint32 delay, Uint32 period) -> TimerHandle;
+    auto insert(Uint32 index) -> void;
+    auto link(Uint32 index, Uint32 slot) -> void;
+    auto unlink(Uint32 index) -> void;
+    auto release(Uint32 index) -> void;
+    auto cascade(int level) -> Uint32;
+    auto tick() -> void;
+
+ public:
+    TimerWheel();
+    explicit TimerWheel(Clock& clock);
+    explicit TimerWheel(Uint32 start_ticks);
+
+    auto now()  const -> Uint32;
+    auto size() const -> std::size_t;
+
+    auto after(Uint32 delay, Callback callback) -> TimerHandle;
+    auto every(Uint32 period, Callback callback) -> TimerHandle;
+    auto every(Uint32 period, Uint32 first_delay, Callback callback) -> TimerHandle;
+
+    auto active(TimerHandle handle)    const -> bool;
+    auto paused(TimerHandle handle)    const -> bool;
+    auto remaining(TimerHandle handle) const -> Uint32;
+
+    auto cancel(TimerHandle handle) -> bool;
+    auto pause(TimerHandle handle)  -> bool;
+    auto resume(TimerHandle handle) -> bool;
+
+    auto advance(Uint32 ticks) -> void;
+    auto update() -> void;
+};
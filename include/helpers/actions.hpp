@@ -0,0 +1,50 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <bitset>
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+#include "input.hpp"
+
+/**
+ * Maps named actions onto key chords and mouse buttons. Bindings are compiled to masks over the
+ * scancode bitset, so evaluating every action is a handful of word-wide ANDs per frame. Edges come from
+ * the snapshot's pressed and released masks, so a tap that starts and ends inside one frame still counts.
+ */
+class ActionMap {
+ public:
+    using Action = std::size_t;
+
+ private:
+    struct Binding {
+        std::bitset<SDL_NUM_SCANCODES> keys;
+        Uint32 buttons;
+    };
+
+    struct State {
+        std::vector<Binding> bindings;
+        bool active;
+        bool pressed;
+        bool released;
+    };
+
+    std::vector<State> actions_;
+
+    auto state(Action action) -> State&;
+
+ public:
+    ActionMap();
+
+    auto bind(Action action, std::initializer_list<SDL_Scancode> chord, Uint32 mouse_buttons=0) -> ActionMap&;
+    auto bindMouse(Action action, Uint32 mouse_buttons) -> ActionMap&;
+    auto clear(Action action) -> ActionMap&;
+
+    auto update(InputSnapshot const& input) -> void;
+
+    auto held(Action action)     const -> bool;
+    auto pressed(Action action)  const -> bool;
+    auto released(Action action) const -> bool;
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+/**
+ * Routes every SDL_malloc made by SDL, SDL_image, SDL_ttf and SDL_mixer through a counting allocator.
+ * Each block is tagged with the phase it was allocated in, so load-time and per-frame use can be told
+ * apart. Allocations the libraries' own dependencies make with plain malloc aren't seen.
+ */
+namespace allocations {
+    enum class Phase: Uint8 { load, frame };
+
+    struct PhaseStats {
+        Uint64 live_bytes;
+        Uint64 live_count;
+        Uint64 total_count;
+    };
+
+    struct Stats {
+        PhaseStats load;
+        PhaseStats frame;
+        Uint64     live_bytes;
+        Uint64     peak_bytes;
+        /** Allocations made between the last two calls to beginFrame() */
+        Uint64     last_frame_count;
+        Uint64     last_frame_bytes;
+    };
+
+    /** Has to run before SDL allocates anything, init() calls it first. Returns false if it was too late. */
+    auto install() -> bool;
+    auto installed() -> bool;
+
+    auto setPhase(Phase phase) -> void;
+    /** Switches to the frame phase and rolls the per-frame counters over */
+    auto beginFrame() -> void;
+
+    /**
+     * Call once a frame with whatever a frame allocator took upstream, e.g. FrameArena::reset(). Once warmup
+     * frames have passed, debug builds abort if that's nonzero and report new highs in live SDL blocks. This
+     * only sees the arena and SDL; src/checks/frame-arena-steady.cpp counts every operator new instead.
+     */
+    auto expectSteady(Uint64 upstream, Uint64 warmup=120) -> void;
+
+    auto stats() -> Stats;
+    /** Prints totals, and whatever is still allocated by phase; install() also runs it at exit */
+    auto report() -> void;
+}
@@ -9,5 +9,7 @@
 auto loadSurface(char const*, ManagedSDLSurface&) -> SDL_Surface*;
 auto loadTextureFromFile(ManagedSDLRenderer&, char const*, std::optional<SDL_Colour>color_key={}) -> SDL_Texture*;
 auto loadTextureFromText(ManagedSDLRenderer&, char const*, ManagedTTFFont&, SDL_Colour const& colour={0, 0, 0, 0xff}) -> SDL_Texture*;
+auto loadResidentTexture(ManagedSDLRenderer&, char const*, std::optional<SDL_Colour>color_key={}) -> residency::ResidentTexture;
+auto createTargetTexture(ManagedSDLRenderer&, int w, int h, Uint32 format=SDL_PIXELFORMAT_ARGB8888) -> SDL_Texture*;
 auto loadFont(char const*, int) -> TTF_Font*;
 auto init() -> bool;
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <bitset>
+
+/** Everything the input devices did during one frame. Plain data, so it can be copied to other threads. */
+struct InputSnapshot {
+    int x;
+    int y;
+    int prevx;
+    int prevy;
+    int dx;
+    int dy;
+
+    Uint32 buttons_down;
+    Uint32 buttons_pressed;
+    Uint32 buttons_released;
+
+    int wheel_x;
+    int wheel_y;
+
+    std::bitset<SDL_NUM_SCANCODES> keys_down;
+    std::bitset<SDL_NUM_SCANCODES> keys_pressed;
+    std::bitset<SDL_NUM_SCANCODES> keys_released;
+
+    auto moved() const -> bool { return x != prevx || y != prevy; }
+    auto anyDown() const -> bool { return buttons_down != 0; }
+
+    auto down(int button)     const -> bool { return buttons_down     & SDL_BUTTON(button); }
+    auto pressed(int button)  const -> bool { return buttons_pressed  & SDL_BUTTON(button); }
+    auto released(int button) const -> bool { return buttons_released & SDL_BUTTON(button); }
+
+    auto keyDown(SDL_Scancode key)     const -> bool { return keys_down[key]; }
+    auto keyPressed(SDL_Scancode key)  const -> bool { return keys_pressed[key]; }
+    auto keyReleased(SDL_Scancode key) const -> bool { return keys_released[key]; }
+};
+
+/** Folds the event stream into an InputSnapshot. Call beginFrame before feeding each frame's events. */
+class InputBuilder {
+ private:
+    InputSnapshot current_;
+
+ public:
+    InputBuilder();
+
+    auto beginFrame() -> void;
+    auto feed(SDL_Event const& event) -> void;
+
+    auto snapshot() const -> InputSnapshot const&;
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <SDL2/SDL_mixer.h>
+
+#include <cstddef>
+#include <string_view>
+
+#if !defined(TRACK_RESOURCES) && (defined(DEBUG) || defined(PROFILING))
+    #define TRACK_RESOURCES
+#endif
+
+/**
+ * Debug and profiling builds keep a record of every live SDL object the helpers create or a
+ * ManagedResource adopts: its kind, where it came from, its size and when it was made. Anything still
+ * alive at exit is listed. Other builds compile all of this away.
+ */
+namespace inventory {
+    enum class Kind: Uint8 { window, renderer, surface, texture, font, chunk, music };
+    constexpr std::size_t KIND_COUNT = 7;
+
+    struct Totals {
+        Uint64 count;
+        Uint64 bytes;
+    };
+
+#ifdef TRACK_RESOURCES
+    /** An empty origin keeps whatever origin the resource was already recorded with */
+    auto add(SDL_Window*   resource, std::string_view origin) -> void;
+    auto add(SDL_Renderer* resource, std::string_view origin) -> void;
+    auto add(SDL_Surface*  resource, std::string_view origin) -> void;
+    auto add(SDL_Texture*  resource, std::string_view origin) -> void;
+    auto add(TTF_Font*     resource, std::string_view origin) -> void;
+    auto add(Mix_Chunk*    resource, std::string_view origin) -> void;
+    auto add(Mix_Music*    resource, std::string_view origin) -> void;
+    auto remove(void const* resource) -> void;
+
+    auto totals(Kind kind) -> Totals;
+    auto dump() -> void;
+#else
+    template<typename Resource>
+    auto add(Resource*, std::string_view) -> void {}
+    inline auto remove(void const*) -> void {}
+
+    inline auto totals(Kind) -> Totals { return {0, 0}; }
+    inline auto dump() -> void {}
+#endif
+
+    /** Records the resource and passes it through, for wrapping creation calls */
+    template<typename Resource>
+    auto track(Resource* resource, std::string_view origin) -> Resource* {
+        if (resource) {
+            add(resource, origin);
+        }
+        return resource;
+    }
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+/** Records polled events and observed ticks to a file, or feeds a recording back in their place */
+namespace replay {
+    enum class Mode { off, record, replay };
+
+    auto mode() -> Mode;
+    auto desyncs() -> int;
+
+    auto startRecording(char const* file_name) -> bool;
+    auto startReplay(char const* file_name) -> bool;
+    auto initFromEnvironment() -> bool;
+    auto stop() -> void;
+
+    auto pollEvent(SDL_Event* event) -> int;
+    auto observeTicks(Uint32 ticks) -> Uint32;
+    auto getTicks() -> Uint32;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <cstddef>
+#include <functional>
+
+#include "TextureView.hpp"
+
+/**
+ * Accounts for the memory held by every texture made through the helpers and keeps reloadable textures
+ * under a budget. Plain textures are only counted; ResidentTextures can be dropped least recently
+ * rendered first and are reloaded the next time they're used. Main thread only.
+ */
+namespace residency {
+    struct Stats {
+        Uint64      bytes;
+        Uint64      peak;
+        Uint64      budget;
+        Uint64      evictions;
+        Uint64      restores;
+        std::size_t textures;
+    };
+
+    /** Width * height * bytes per pixel, ignoring any padding the driver adds */
+    auto textureBytes(SDL_Texture* texture) -> Uint64;
+
+    /** Counts the texture until destroyTexture() is called on it. Returns it, so creation calls can be wrapped. */
+    auto track(SDL_Texture* texture) -> SDL_Texture*;
+    /** Deleter for every texture, tracked or not */
+    auto destroyTexture(SDL_Texture* texture) -> void;
+
+    /** Zero means no limit */
+    auto setBudget(Uint64 bytes) -> void;
+    /** Textures used in the current frame are never evicted, so views taken this frame stay valid until the next */
+    auto beginFrame() -> void;
+    auto stats() -> Stats;
+
+
+    /** Texture that can be recreated from its loader, so the manager may drop it while it isn't being drawn */
+    class ResidentTexture {
+     public:
+        using Loader = std::function<SDL_Texture*()>;
+
+     private:
+        std::size_t slot_;
+
+     public:
+        ResidentTexture();
+        /** Loads straight away so a bad path is reported at load time */
+        explicit ResidentTexture(Loader load);
+        ~ResidentTexture();
+
+        ResidentTexture(ResidentTexture const&)                    = delete;
+        auto operator=(ResidentTexture const&) -> ResidentTexture& = delete;
+        ResidentTexture(ResidentTexture&& other);
+        auto operator=(ResidentTexture&& other) -> ResidentTexture&;
+
+        /** False if it has no loader or the last load failed */
+        explicit operator bool() const;
+        auto resident() const -> bool;
+
+        /** Reloads the texture if it was evicted and marks it used this frame */
+        auto get() -> SDL_Texture*;
+        auto view() -> TextureView;
+
+        auto render(SDL_Renderer* renderer, SDL_Rect* clip=nullptr) -> void;
+    };
+}
@@ -0,0 +1,176 @@
+// Copyright 2020 Nathaniel Mitchell
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_ttf.h>
+#include <SDL2/SDL_mixer.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#include "SDL_helpers.hpp"
+#include "SDL_components.hpp"
+
+using std::cout;
+
+
+/*
+ * Runs the HUD half of SDL-25's frame loop headlessly, on the dummy video driver and a software renderer,
+ * and fails if any frame after warm-up calls operator new. allocations::expectSteady() only sees the frame
+ * arena and SDL's own blocks, this sees everything the C++ side of a frame does. Build it without -p, the
+ * profiler allocates as it records zones, and run it from bin/ so the font is found:
+ *
+ *     ./build -d -s src/checks/frame-arena-steady.cpp
+ */
+
+const auto SCREEN_WIDTH  = 640;
+const auto SCREEN_HEIGHT = 480;
+
+const auto FRAMES = 600;
+const auto WARMUP = 60;
+
+
+static auto heap_allocations = std::atomic<Uint64>{0};
+
+auto operator new(std::size_t size) -> void* {
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto memory = std::malloc(size > 0 ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc{};
+}
+
+auto operator new(std::size_t size, std::align_val_t alignment) -> void* {
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    auto align = static_cast<std::size_t>(alignment);
+    // aligned_alloc wants the size to be a multiple of the alignment
+    if (auto memory = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+        return memory;
+    }
+    throw std::bad_alloc{};
+}
+
+auto operator delete(void* memory) noexcept -> void                                        { std::free(memory); }
+auto operator delete(void* memory, std::size_t) noexcept -> void                           { std::free(memory); }
+auto operator delete(void* memory, std::align_val_t) noexcept -> void                      { std::free(memory); }
+auto operator delete(void* memory, std::size_t, std::align_val_t) noexcept -> void         { std::free(memory); }
+
+
+struct ProgramData {
+    ManagedSDLWindow    window;
+    ManagedSDLRenderer  renderer;
+
+    GlyphStrip          glyphs;
+
+    ManagedTTFFont      font;
+};
+
+
+auto run() -> bool;
+auto loadData(ProgramData&) -> bool;
+
+
+int main(__attribute__((unused))int argc, __attribute__((unused))char *argv[]) {
+    // Nothing is shown, so this runs the same on a desktop and on a machine without a display
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
+
+    auto passed = run();
+    TTF_Quit();
+    IMG_Quit();
+    SDL_Quit();
+    return passed ? 0 : 1;
+}
+
+
+auto run() -> bool {
+    auto data       = ProgramData{};
+    auto black      = SDL_Colour{0, 0, 0, 0xff};
+    auto time_text  = HudText{};
+    auto arena      = FrameArena{};
+    auto stats      = FrameStats{};
+
+    auto failed_frames = 0;
+
+    if (!init()) {
+        cout << "Failed to initialize.\n";
+        return false;
+    }
+
+    if (!loadData(data)) {
+        cout << "Failed to load data.\n";
+        return false;
+    }
+
+    for (auto frame = 0; frame < FRAMES; frame++) {
+        auto before = heap_allocations.load(std::memory_order_relaxed);
+
+        stats.beginFrame();
+        allocations::beginFrame();
+        allocations::expectSteady(arena.reset(), WARMUP);
+
+        time_text.clear().append("Frame ").append(frame)
+                 .append(" (p99 ").append(stats.total().p99 / 1e6, 2).append(" ms)");
+
+        // Transient per-frame data the way a batching renderer builds it, grown without a reserve
+        auto cells = arena.vector<SDL_Rect>();
+        for (auto i = 0; i < 1000; i++) {
+            cells.push_back(SDL_Rect{(i % 40) * 16, (i / 40) * 16, 15, 15});
+        }
+        auto label = arena.format("%zu cells, %zu arena bytes", cells.size(), arena.used());
+
+        SDL_SetRenderDrawColor(data.renderer, 0xFF, 0xFF, 0xFF, 0xFF);
+        SDL_RenderClear(data.renderer);
+
+        SDL_SetRenderDrawColor(data.renderer, 0xC0, 0xC0, 0xC0, 0xFF);
+        SDL_RenderFillRects(data.renderer, cells.data(), static_cast<int>(cells.size()));
+
+        data.glyphs.render(data.renderer, arena, time_text.text(), {2, (SCREEN_HEIGHT-data.glyphs.height()) / 2}, black);
+        data.glyphs.render(data.renderer, arena, label, {2, SCREEN_HEIGHT - data.glyphs.height()}, black);
+
+        stats.beginPresent();
+        SDL_RenderPresent(data.renderer);
+        stats.endPresent();
+
+        auto allocated = heap_allocations.load(std::memory_order_relaxed) - before;
+        if (frame >= WARMUP && allocated > 0) {
+            cout << "Frame " << frame << " made " << allocated << " heap allocations\n";
+            failed_frames++;
+        }
+    }
+
+    if (failed_frames > 0) {
+        cout << failed_frames << " of " << FRAMES - WARMUP << " steady frames allocated\n";
+        return false;
+    }
+
+    cout << "No heap allocations in " << FRAMES - WARMUP << " steady frames, arena peaked at "
+         << arena.peak() << " bytes\n";
+    return true;
+}
+
+
+auto loadData(ProgramData& data) -> bool {
+    // Create window
+    data.window = SDL_CreateWindow("Frame arena check", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_HIDDEN);
+    if (!data.window) {
+        cout << "Window could not be created. SDL_Error: " << SDL_GetError() << "\n";
+        return false;
+    }
+
+    // The dummy driver has no accelerated renderer
+    data.renderer = SDL_CreateRenderer(data.window, -1, SDL_RENDERER_SOFTWARE);
+    if (!data.renderer) {
+        cout << "Renderer could not be created. SDL_Error: " << SDL_GetError() << "\n";
+        return false;
+    }
+
+    data.font = loadFont("fonts/lazy.ttf", 28);
+    if (!data.font) { return false; }
+
+    if (!data.glyphs.build(data.renderer, data.font)) { return false; }
+
+    return true;
+}
@@ -1,59 +1,48 @@
 #include "components/Button.hpp"
 
-auto Button::isHovering() -> bool { return hovering_; }
-auto Button::isClicking() -> bool { return clicking_; }
-auto Button::isClicked()  -> bool { return clicked_; }
+Button::Button(TextureView texture_default, TextureView texture_hovering, TextureView texture_clicking,
+               SDL_Rect const& area):   texture_default_(texture_default),
+                                        texture_hovering_(texture_hovering),
+                                        texture_clicking_(texture_clicking),
+                                        rect_(area),
+                                        slot_() {}
+
+auto Button::attach(WidgetSet& set) -> void { slot_.attach(set, rect_); }
+auto Button::detach() -> void { slot_.detach(); }
+
+auto Button::isHovering() -> bool { return slot_.state() & widget::HOVERING; }
+auto Button::isClicking() -> bool { return slot_.state() & widget::CLICKING; }
+auto Button::isClicked()  -> bool { return slot_.state() & widget::CLICKED; }
 
 auto Button::pos()  const -> SDL_Point { return {rect_.x, rect_.y}; }
 auto Button::dim()  const -> SDL_Point { return {rect_.w, rect_.h}; }
 auto Button::rect() const -> SDL_Rect const&  { return rect_; }
 
-auto Button::setPos(SDL_Point pos) -> void { rect_.x = pos.x; rect_.y = pos.y; }
-auto Button::setDim(SDL_Point dim) -> void { rect_.w = dim.x; rect_.h = dim.y; }
-auto Button::setRect(SDL_Rect const& rect) -> void { rect_ = rect; }
+auto Button::setPos(SDL_Point pos) -> void { rect_.x = pos.x; rect_.y = pos.y; slot_.setRect(rect_); }
+auto Button::setDim(SDL_Point dim) -> void { rect_.w = dim.x; rect_.h = dim.y; slot_.setRect(rect_); }
+auto Button::setRect(SDL_Rect const& rect) -> void { rect_ = rect; slot_.setRect(rect_); }
 
 auto Button::update() -> void {
-    clicked_ = false;
-
-    if (mouse::x() > rect_.x && mouse::x() < rect_.x+rect_.w && mouse::y() > rect_.y && mouse::y() < rect_.y+rect_.h) {
-        if (mouse::pressed()) {
-            if (hovering_) {
-                // Mouse has entered and now mouse is clicked
-                clicking_ = true;
-            } else {
-                // Mouse entered already clicked.
-                hovering_ = false;
-                clicking_ = false;
-                clicked_  = false;
-            }
-        } else if (!mouse::pressed() && clicking_) {
-            // Mouse was down last update, and now it is released.
-            clicking_ = false;
-            clicked_ = true;
-        } else {
-            // Otherwise mouse is simply hovering
-            hovering_ = true;
-            clicking_ = false;
-        }
-    } else if (mouse::pressed() && clicking_) {
-        // Mouse was down and in bounds last frame, hold clicking state
-        hovering_ = false;
-    } else {
-        // Mouse is up and out of bounds
-        hovering_ = false;
-        clicking_ = false;
-        clicked_  = false;
-    }
+    step({mouse::x(), mouse::y()}, mouse::pressed());
+}
 
-    if (clicking_) {
-        current_texture_ = &texture_clicking_;
-    } else if (hovering_) {
-        current_texture_ = &texture_hovering_;
-    } else {
-        current_texture_ = &texture_default_;
-    }
+auto Button::update(InputSnapshot const& input) -> void {
+    step({input.x, input.y}, input.anyDown());
+}
+
+auto Button::step(SDL_Point const& mouse, bool pressed) -> void {
+    PROFILE_ZONE("Button::update");
+
+    slot_.advance(widget::inside(rect_, mouse.x, mouse.y), pressed);
 }
 
 auto Button::render(SDL_Renderer* renderer) -> void {
-    current_texture_->render(renderer, &rect_);
+    // Picked from state at draw time, a stored pointer would dangle once the button is copied
+    if (isClicking()) {
+        texture_clicking_.render(renderer, &rect_);
+    } else if (isHovering()) {
+        texture_hovering_.render(renderer, &rect_);
+    } else {
+        texture_default_.render(renderer, &rect_);
+    }
 }
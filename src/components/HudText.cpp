@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <charconv>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+#include "components/HudText.hpp"
+
+using std::cout;
+
+
+GlyphStrip::GlyphStrip(): texture_(), glyphs_(), height_(0) {}
+
+auto GlyphStrip::build(ManagedSDLRenderer& renderer, ManagedTTFFont& font) -> bool {
+    PROFILE_FUNCTION();
+
+    // Rasterise every glyph first so the strip can be allocated at its final width
+    auto surfaces = std::vector<ManagedSDLSurface>{};
+    auto width    = 0;
+    height_       = TTF_FontHeight(font);
+
+    for (auto c = FIRST; c <= LAST; c++) {
+        auto& glyph = glyphs_[static_cast<std::size_t>(c - FIRST)];
+        auto surface = ManagedSDLSurface{TTF_RenderGlyph_Blended(font, static_cast<Uint16>(c), SDL_Colour{0xff, 0xff, 0xff, 0xff})};
+        if (!surface || TTF_GlyphMetrics(font, static_cast<Uint16>(c), nullptr, nullptr, nullptr, nullptr, &glyph.advance) != 0) {
+            cout << "Unable to render glyph '" << c << "'. SDL_ttf Error: " << TTF_GetError() << "\n";
+            return false;
+        }
+
+        glyph.source = {width, 0, surface->w, std::min(surface->h, height_)};
+        width += surface->w;
+        surfaces.push_back(std::move(surface));
+    }
+
+    auto strip = ManagedSDLSurface{SDL_CreateRGBSurfaceWithFormat(0, width, height_, 32, SDL_PIXELFORMAT_ARGB8888)};
+    if (!strip) {
+        cout << "Unable to create glyph strip. SDL Error: " << SDL_GetError() << "\n";
+        return false;
+    }
+
+    // Copy the glyphs' alpha as-is instead of blending them onto the empty strip
+    for (auto index = std::size_t{0}; index < surfaces.size(); index++) {
+        auto destination = glyphs_[index].source;
+        SDL_SetSurfaceBlendMode(surfaces[index], SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(surfaces[index], nullptr, strip, &destination);
+    }
+
+    texture_ = inventory::track(residency::track(SDL_CreateTextureFromSurface(renderer, strip)), "glyph strip");
+    if (!texture_) {
+        cout << "Unable to create texture from glyph strip. SDL Error: " << SDL_GetError() << "\n";
+        return false;
+    }
+    texture_.setBlendMode(SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+auto GlyphStrip::glyph(char c) const -> Glyph const& {
+    if (c < FIRST || c > LAST) {
+        c = '?';
+    }
+    return glyphs_[static_cast<std::size_t>(c - FIRST)];
+}
+
+auto GlyphStrip::height() const -> int { return height_; }
+
+auto GlyphStrip::measure(std::string_view text) const -> SDL_Point {
+    auto width = 0;
+    for (auto c : text) {
+        width += glyph(c).advance;
+    }
+    return {width, height_};
+}
+
+auto GlyphStrip::render(SDL_Renderer* renderer, std::string_view text, SDL_Point pos, SDL_Colour const& colour) const -> SDL_Point {
+    PROFILE_ZONE("GlyphStrip::render");
+
+    SDL_SetTextureColorMod(texture_, colour.r, colour.g, colour.b);
+    SDL_SetTextureAlphaMod(texture_, colour.a);
+    for (auto c : text) {
+        auto const& g = glyph(c);
+        auto destination = SDL_Rect{pos.x, pos.y, g.source.w, g.source.h};
+        SDL_RenderCopy(renderer, texture_, &g.source, &destination);
+        pos.x += g.advance;
+    }
+    return pos;
+}
+
+/** Falls back to a copy per glyph on SDL older than 2.0.18, which has no SDL_RenderGeometry */
+auto GlyphStrip::render(SDL_Renderer* renderer, FrameArena& arena, std::string_view text, SDL_Point pos,
+                        SDL_Colour const& colour) const -> SDL_Point {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    PROFILE_ZONE("GlyphStrip::render");
+
+    auto vertices = arena.vector<SDL_Vertex>();
+    auto indices  = arena.vector<int>();
+    vertices.reserve(text.size() * 4);
+    indices.reserve(text.size() * 6);
+
+    auto const& last = glyphs_.back().source;
+    auto width  = static_cast<float>(last.x + last.w);
+    auto height = static_cast<float>(height_);
+
+    for (auto c : text) {
+        auto const& g = glyph(c);
+        auto first = static_cast<int>(vertices.size());
+
+        auto x0 = static_cast<float>(pos.x);
+        auto y0 = static_cast<float>(pos.y);
+        auto x1 = x0 + static_cast<float>(g.source.w);
+        auto y1 = y0 + static_cast<float>(g.source.h);
+        auto u0 = static_cast<float>(g.source.x) / width;
+        auto u1 = static_cast<float>(g.source.x + g.source.w) / width;
+        auto v1 = static_cast<float>(g.source.h) / height;
+
+        vertices.push_back(SDL_Vertex{{x0, y0}, colour, {u0, 0.0f}});
+        vertices.push_back(SDL_Vertex{{x1, y0}, colour, {u1, 0.0f}});
+        vertices.push_back(SDL_Vertex{{x0, y1}, colour, {u0, v1}});
+        vertices.push_back(SDL_Vertex{{x1, y1}, colour, {u1, v1}});
+        for (auto corner : {0, 1, 2, 2, 1, 3}) {
+            indices.push_back(first + corner);
+        }
+        pos.x += g.advance;
+    }
+
+    // The vertex colours do the tinting
+    SDL_SetTextureColorMod(texture_, 0xff, 0xff, 0xff);
+    SDL_SetTextureAlphaMod(texture_, 0xff);
+    SDL_RenderGeometry(renderer, texture_, vertices.data(), static_cast<int>(vertices.size()),
+                       indices.data(), static_cast<int>(indices.size()));
+    return pos;
+#else
+    static_cast<void>(arena);
+    return render(renderer, text, pos, colour);
+#endif
+}
+
+
+HudText::HudText(): buffer_(), size_(0) {}
+
+auto HudText::clear() -> HudText& {
+    size_ = 0;
+    return *this;
+}
+
+auto HudText::append(std::string_view text) -> HudText& {
+    auto count = std::min(text.size(), CAPACITY - size_);
+    std::copy_n(text.data(), count, buffer_.data() + size_);
+    size_ += count;
+    return *this;
+}
+
+auto HudText::append(double value, int precision) -> HudText& {
+    auto result = std::to_chars(buffer_.data() + size_, buffer_.data() + CAPACITY, value, std::chars_format::fixed, precision);
+    if (result.ec == std::errc{}) {
+        size_ = static_cast<std::size_t>(result.ptr - buffer_.data());
+    }
+    return *this;
+}
+
+auto HudText::text() const -> std::string_view { return {buffer_.data(), size_}; }
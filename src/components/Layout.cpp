@@ -0,0 +1,251 @@
+#include <algorithm>
+#include <vector>
+
+#include "components/Layout.hpp"
+
+static auto sameRect(SDL_Rect const& a, SDL_Rect const& b) -> bool {
+    return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+}
+
+
+Layout::Layout(SDL_Rect const& area): nodes_(), area_(area), placed_(0) {
+    add(NONE, Kind::frame);
+}
+
+auto Layout::root() const -> NodeId { return 0; }
+
+auto Layout::add(NodeId parent, Kind kind) -> NodeId {
+    auto id = static_cast<NodeId>(nodes_.size());
+    nodes_.push_back(Node{kind, parent, {},
+                          Axis::vertical, 0, 0.5f, 1, 1,
+                          {0.0f, 0.0f}, {0, 0}, false,
+                          {-1, -1}, {nullptr, nullptr, nullptr},
+                          {0, 0}, {0, 0, 0, 0}, true, true});
+    if (parent != NONE) {
+        nodes_[parent].children.push_back(id);
+        invalidate(parent);
+    }
+    return id;
+}
+
+auto Layout::frame(NodeId parent) -> NodeId { return add(parent, Kind::frame); }
+
+auto Layout::stack(NodeId parent, Axis axis, int spacing, float align) -> NodeId {
+    auto id = add(parent, Kind::stack);
+    nodes_[id].axis    = axis;
+    nodes_[id].spacing = spacing;
+    nodes_[id].align   = align;
+    return id;
+}
+
+auto Layout::grid(NodeId parent, int cols, int rows, int spacing) -> NodeId {
+    auto id = add(parent, Kind::grid);
+    nodes_[id].cols    = std::max(cols, 1);
+    nodes_[id].rows    = std::max(rows, 1);
+    nodes_[id].spacing = spacing;
+    return id;
+}
+
+auto Layout::leaf(NodeId parent, Target const& target, SDL_Point size) -> NodeId {
+    auto id = add(parent, Kind::leaf);
+    nodes_[id].target = target;
+    nodes_[id].size   = size;
+    return id;
+}
+
+auto Layout::leaf(NodeId parent, TextureComponent& component) -> NodeId {
+    auto place   = [](void* target, SDL_Rect const& rect) { static_cast<TextureComponent*>(target)->setRect(rect); };
+    auto measure = [](void* target) { return static_cast<TextureComponent*>(target)->texture().dim(); };
+    return leaf(parent, Target{&component, place, measure}, {-1, -1});
+}
+
+
+auto Layout::anchor(NodeId id, float x, float y, SDL_Point offset) -> Layout& {
+    nodes_[id].anchor = {x, y};
+    nodes_[id].offset = offset;
+    invalidate(id);
+    return *this;
+}
+
+auto Layout::fill(NodeId id, bool fill) -> Layout& {
+    nodes_[id].fill = fill;
+    invalidate(id);
+    return *this;
+}
+
+auto Layout::setSize(NodeId id, SDL_Point size) -> Layout& {
+    nodes_[id].size = size;
+    invalidate(id);
+    return *this;
+}
+
+auto Layout::setArea(SDL_Rect const& area) -> Layout& {
+    area_ = area;
+    nodes_[root()].arrange_dirty = true;
+    return *this;
+}
+
+
+/** Stops climbing at the first node that's already dirty, the rest of its path was marked with it */
+auto Layout::invalidate(NodeId id) -> void {
+    while (id != NONE && !nodes_[id].measure_dirty) {
+        nodes_[id].measure_dirty = true;
+        nodes_[id].arrange_dirty = true;
+        id = nodes_[id].parent;
+    }
+}
+
+auto Layout::contentChanged(NodeId id) -> bool {
+    auto& node = nodes_[id];
+    if (!node.target.measure) {
+        return false;
+    }
+
+    // Axes with a fixed size don't care what the content does
+    auto content  = node.target.measure(node.target.widget);
+    auto expected = SDL_Point{node.size.x >= 0 ? node.size.x : content.x,
+                              node.size.y >= 0 ? node.size.y : content.y};
+    if (expected.x == node.measured.x && expected.y == node.measured.y) {
+        return false;
+    }
+    invalidate(id);
+    return true;
+}
+
+
+/** Clean nodes answer from their cache, so only dirty paths are walked */
+auto Layout::measure(NodeId id) -> SDL_Point {
+    if (!nodes_[id].measure_dirty) {
+        return nodes_[id].measured;
+    }
+
+    auto content = SDL_Point{0, 0};
+    auto count   = static_cast<int>(nodes_[id].children.size());
+
+    switch (nodes_[id].kind) {
+        case Kind::leaf:
+            if (nodes_[id].target.measure) {
+                content = nodes_[id].target.measure(nodes_[id].target.widget);
+            }
+            break;
+
+        case Kind::frame:
+            for (auto child : nodes_[id].children) {
+                auto size = measure(child);
+                content = {std::max(content.x, size.x), std::max(content.y, size.y)};
+            }
+            break;
+
+        case Kind::stack: {
+            auto horizontal = nodes_[id].axis == Axis::horizontal;
+            for (auto child : nodes_[id].children) {
+                auto size = measure(child);
+                if (horizontal) {
+                    content = {content.x + size.x, std::max(content.y, size.y)};
+                } else {
+                    content = {std::max(content.x, size.x), content.y + size.y};
+                }
+            }
+            auto gaps = std::max(count - 1, 0) * nodes_[id].spacing;
+            (horizontal ? content.x : content.y) += gaps;
+            break;
+        }
+
+        case Kind::grid: {
+            auto cell = SDL_Point{0, 0};
+            for (auto child : nodes_[id].children) {
+                auto size = measure(child);
+                cell = {std::max(cell.x, size.x), std::max(cell.y, size.y)};
+            }
+            auto const& node = nodes_[id];
+            content = {node.cols * cell.x + (node.cols - 1) * node.spacing,
+                       node.rows * cell.y + (node.rows - 1) * node.spacing};
+            break;
+        }
+    }
+
+    auto& node = nodes_[id];
+    auto measured = SDL_Point{node.size.x >= 0 ? node.size.x : content.x,
+                              node.size.y >= 0 ? node.size.y : content.y};
+
+    node.measure_dirty = false;
+    if (measured.x != node.measured.x || measured.y != node.measured.y) {
+        node.measured = measured;
+        if (node.parent != NONE) {
+            nodes_[node.parent].arrange_dirty = true;
+        }
+    }
+    return node.measured;
+}
+
+/** A node that is clean and lands on the same rect as last time keeps its whole subtree */
+auto Layout::arrange(NodeId id, SDL_Rect const& rect) -> void {
+    if (!nodes_[id].arrange_dirty && sameRect(nodes_[id].rect, rect)) {
+        return;
+    }
+
+    nodes_[id].rect          = rect;
+    nodes_[id].arrange_dirty = false;
+    placed_++;
+
+    auto const& node = nodes_[id];
+    switch (node.kind) {
+        case Kind::leaf:
+            if (node.target.place) {
+                node.target.place(node.target.widget, rect);
+            }
+            break;
+
+        case Kind::frame:
+            for (auto child : node.children) {
+                auto const& c = nodes_[child];
+                auto size = c.fill ? SDL_Point{rect.w, rect.h} : c.measured;
+                arrange(child, {rect.x + static_cast<int>(static_cast<float>(rect.w - size.x) * c.anchor.x) + c.offset.x,
+                                rect.y + static_cast<int>(static_cast<float>(rect.h - size.y) * c.anchor.y) + c.offset.y,
+                                size.x,
+                                size.y});
+            }
+            break;
+
+        case Kind::stack: {
+            auto horizontal = node.axis == Axis::horizontal;
+            auto cursor     = horizontal ? rect.x : rect.y;
+            for (auto child : node.children) {
+                auto size = nodes_[child].measured;
+                if (horizontal) {
+                    arrange(child, {cursor, rect.y + static_cast<int>(static_cast<float>(rect.h - size.y) * node.align), size.x, size.y});
+                    cursor += size.x + node.spacing;
+                } else {
+                    arrange(child, {rect.x + static_cast<int>(static_cast<float>(rect.w - size.x) * node.align), cursor, size.x, size.y});
+                    cursor += size.y + node.spacing;
+                }
+            }
+            break;
+        }
+
+        case Kind::grid: {
+            // Cells share out the whole rect, children stretch to fill their cell
+            auto cell_w = (rect.w - (node.cols - 1) * node.spacing) / node.cols;
+            auto cell_h = (rect.h - (node.rows - 1) * node.spacing) / node.rows;
+            auto index  = 0;
+            for (auto child : node.children) {
+                auto col = index % node.cols;
+                auto row = index / node.cols;
+                arrange(child, {rect.x + col * (cell_w + node.spacing), rect.y + row * (cell_h + node.spacing), cell_w, cell_h});
+                index++;
+            }
+            break;
+        }
+    }
+}
+
+auto Layout::update() -> int {
+    PROFILE_ZONE("Layout::update");
+
+    placed_ = 0;
+    measure(root());
+    arrange(root(), area_);
+    return placed_;
+}
+
+auto Layout::rect(NodeId id) const -> SDL_Rect const& { return nodes_[id].rect; }
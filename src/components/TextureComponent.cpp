@@ -2,60 +2,45 @@
 
 TextureComponent::TextureComponent():   texture_(),
                                         rect_({0, 0, 0, 0}),
-                                        hovering_(false),
-                                        clicking_(false),
-                                        clicked_(false) {}
+                                        slot_() {}
 
 auto TextureComponent::texture() -> ManagedSDLTexture& { return texture_; }
 
-auto TextureComponent::isHovering() const -> bool { return hovering_; }
-auto TextureComponent::isClicking() const -> bool { return clicking_; }
-auto TextureComponent::isClicked()  const -> bool { return clicked_; }
+auto TextureComponent::attach(WidgetSet& set) -> void { slot_.attach(set, rect_); }
+auto TextureComponent::detach() -> void { slot_.detach(); }
+
+auto TextureComponent::isHovering() const -> bool { return slot_.state() & widget::HOVERING; }
+auto TextureComponent::isClicking() const -> bool { return slot_.state() & widget::CLICKING; }
+auto TextureComponent::isClicked()  const -> bool { return slot_.state() & widget::CLICKED; }
 
 auto TextureComponent::pos()  const -> SDL_Point { return {rect_.x, rect_.y}; }
 auto TextureComponent::dim()  const -> SDL_Point { return {rect_.w, rect_.h}; }
 auto TextureComponent::rect() const -> SDL_Rect const&  { return rect_; }
 
-auto TextureComponent::setPos(SDL_Point const& pos)  -> TextureComponent& { rect_.x =  pos.x; rect_.y =  pos.y; return *this; }
-auto TextureComponent::setPos(SDL_Rect  const& rect) -> TextureComponent& { rect_.x = rect.x; rect_.y = rect.y; return *this; }
-auto TextureComponent::setDim(SDL_Point const& dim)  -> TextureComponent& { rect_.w =  dim.x; rect_.h =  dim.y; return *this; }
-auto TextureComponent::setDim(SDL_Rect  const& rect) -> TextureComponent& { rect_.w = rect.w; rect_.h = rect.h; return *this; }
-auto TextureComponent::setRect(SDL_Rect const& rect) -> TextureComponent& { rect_ = rect; return *this; }
+auto TextureComponent::setPos(SDL_Point const& pos)  -> TextureComponent& { rect_.x =  pos.x; rect_.y =  pos.y; slot_.setRect(rect_); return *this; }
+auto TextureComponent::setPos(SDL_Rect  const& rect) -> TextureComponent& { rect_.x = rect.x; rect_.y = rect.y; slot_.setRect(rect_); return *this; }
+auto TextureComponent::setDim(SDL_Point const& dim)  -> TextureComponent& { rect_.w =  dim.x; rect_.h =  dim.y; slot_.setRect(rect_); return *this; }
+auto TextureComponent::setDim(SDL_Rect  const& rect) -> TextureComponent& { rect_.w = rect.w; rect_.h = rect.h; slot_.setRect(rect_); return *this; }
+auto TextureComponent::setRect(SDL_Rect const& rect) -> TextureComponent& { rect_ = rect; slot_.setRect(rect_); return *this; }
 
 auto TextureComponent::setDimToTexture() -> TextureComponent& { setDim(texture_.dim()); return *this; }
 
 auto TextureComponent::update() -> void {
-    clicked_ = false;
+    step({mouse::x(), mouse::y()}, mouse::pressed());
+}
+
+auto TextureComponent::update(InputSnapshot const& input) -> void {
+    step({input.x, input.y}, input.anyDown());
+}
+
+auto TextureComponent::step(SDL_Point const& mouse, bool pressed) -> void {
+    PROFILE_ZONE("TextureComponent::update");
+
+    advance(widget::inside(rect_, mouse.x, mouse.y), pressed);
+}
 
-    if (mouse::x() > rect_.x && mouse::x() < rect_.x+rect_.w && mouse::y() > rect_.y && mouse::y() < rect_.y+rect_.h) {
-        if (mouse::pressed()) {
-            if (hovering_) {
-                // Mouse has entered and now mouse is clicked
-                clicking_ = true;
-            } else {
-                // Mouse entered already clicked.
-                hovering_ = false;
-                clicking_ = false;
-                clicked_  = false;
-            }
-        } else if (!mouse::pressed() && clicking_) {
-            // Mouse was down last update, and now it is released.
-            clicking_ = false;
-            clicked_ = true;
-        } else {
-            // Otherwise mouse is simply hovering
-            hovering_ = true;
-            clicking_ = false;
-        }
-    } else if (mouse::pressed() && clicking_) {
-        // Mouse was down and in bounds last frame, hold clicking state
-        hovering_ = false;
-    } else {
-        // Mouse is up and out of bounds
-        hovering_ = false;
-        clicking_ = false;
-        clicked_  = false;
-    }
+auto TextureComponent::advance(bool inside, bool pressed) -> bool {
+    return slot_.advance(inside, pressed);
 }
 
 
@@ -74,10 +59,12 @@ auto TextureComponent::operator=(ManagedSDLTexture&& managed_texture) -> Texture
 auto TextureComponent::operator=(TextureComponent& other)  -> TextureComponent& {
     texture_ = other.texture_;
     rect_    = other.rect_;
+    slot_.setRect(rect_);
     return *this;
 }
 auto TextureComponent::operator=(TextureComponent&& other) -> TextureComponent& {
     texture_ = std::move(other.texture_);
     rect_    = other.rect_;
+    slot_.setRect(rect_);
     return *this;
 }
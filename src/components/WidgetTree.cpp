@@ -0,0 +1,277 @@
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "components/WidgetTree.hpp"
+
+
+WidgetTree::WidgetTree(SDL_Rect const& bounds):    nodes_(),
+                                                    states_(),
+                                                    path_(),
+                                                    next_path_(),
+                                                    active_(),
+                                                    next_active_(),
+                                                    damage_(),
+                                                    bounds_(bounds),
+                                                    frame_(0),
+                                                    clicked_pending_(false) {
+    nodes_.push_back(Node{nullptr, NONE, {}, {}, 0, bounds, true, false, true, true});
+}
+
+/** Widgets usually outlive the tree, so they take their state back rather than keep pointing into it */
+WidgetTree::~WidgetTree() {
+    for (auto const& node : nodes_) {
+        if (node.widget) {
+            node.widget->detach();
+        }
+    }
+}
+
+auto WidgetTree::root() const -> NodeId { return 0; }
+
+auto WidgetTree::add(NodeId parent, TextureComponent& widget) -> NodeId {
+    auto id = static_cast<NodeId>(nodes_.size());
+    nodes_.push_back(Node{&widget, parent, {}, {}, 0, {0, 0, 0, 0}, true, false, false, false});
+    nodes_[parent].children.push_back(id);
+    widget.attach(states_);
+    markDirty(id);
+    return id;
+}
+
+auto WidgetTree::on(NodeId id, Handler handler) -> WidgetTree& {
+    nodes_[id].handler = std::move(handler);
+    return *this;
+}
+
+auto WidgetTree::setVisible(NodeId id, bool visible) -> WidgetTree& {
+    if (nodes_[id].visible != visible) {
+        nodes_[id].visible = visible;
+        markDirty(id);
+    }
+    return *this;
+}
+
+/** Stops climbing at the first ancestor already flagged, since everything above it must be flagged too */
+auto WidgetTree::markDirty(NodeId id) -> void {
+    nodes_[id].dirty = true;
+    for (auto up = id; up != NONE && !nodes_[up].dirty_below; up = nodes_[up].parent) {
+        nodes_[up].dirty_below = true;
+    }
+}
+
+auto WidgetTree::markDirty() -> void { markDirty(root()); }
+
+auto WidgetTree::widget(NodeId id) const -> TextureComponent* { return nodes_[id].widget; }
+auto WidgetTree::parent(NodeId id) const -> NodeId { return nodes_[id].parent; }
+auto WidgetTree::hovered() const -> NodeId { return path_.empty() ? NONE : path_.back(); }
+auto WidgetTree::dirty() const -> bool { return nodes_[root()].dirty_below; }
+
+
+auto WidgetTree::inside(NodeId id, SDL_Point const& point) const -> bool {
+    auto const& node = nodes_[id];
+    return node.visible && (!node.widget || widget::inside(node.widget->rect(), point.x, point.y));
+}
+
+/** Only descends into the child that was hit, so the cost is the depth times the fan-out along one path */
+auto WidgetTree::hit(SDL_Point const& point) const -> NodeId {
+    auto id = root();
+    auto descended = true;
+    while (descended) {
+        descended = false;
+        auto const& children = nodes_[id].children;
+        for (auto child = children.rbegin(); child != children.rend(); ++child) {
+            if (inside(*child, point)) {
+                id = *child;
+                descended = true;
+                break;
+            }
+        }
+    }
+    return id;
+}
+
+
+auto WidgetTree::step(NodeId id, bool pressed) -> void {
+    auto& node = nodes_[id];
+    if (node.stepped == frame_ || !node.widget) {
+        return;
+    }
+    node.stepped = frame_;
+
+    if (node.widget->advance(node.on_path, pressed)) {
+        markDirty(id);
+    }
+    if (node.widget->isClicked()) {
+        clicked_pending_ = true;
+    }
+    if (node.widget->isHovering() || node.widget->isClicking() || node.widget->isClicked()) {
+        next_active_.push_back(id);
+    }
+}
+
+auto WidgetTree::send(EventType type, NodeId target, SDL_Point const& point) -> void {
+    auto const& handler = nodes_[target].handler;
+    if (handler) {
+        handler(Event{type, target, target, point});
+    }
+}
+
+auto WidgetTree::bubble(EventType type, NodeId target, SDL_Point const& point) -> void {
+    for (auto id = target; id != NONE; id = nodes_[id].parent) {
+        auto const& handler = nodes_[id].handler;
+        if (handler && handler(Event{type, target, id, point})) {
+            return;
+        }
+    }
+}
+
+auto WidgetTree::update(InputSnapshot const& input) -> bool {
+    if (!input.moved() && !input.buttons_pressed && !input.buttons_released && !clicked_pending_) {
+        return false;
+    }
+    PROFILE_ZONE("WidgetTree::update");
+
+    frame_++;
+    clicked_pending_ = false;
+
+    auto point   = SDL_Point{input.x, input.y};
+    auto pressed = input.anyDown();
+
+    // Hit-test once and record the hovered path from the root down
+    next_path_.clear();
+    for (auto id = hit(point); id != NONE; id = nodes_[id].parent) {
+        next_path_.push_back(id);
+    }
+    std::reverse(next_path_.begin(), next_path_.end());
+
+    for (auto id : path_) {
+        nodes_[id].on_path = false;
+    }
+    for (auto id : next_path_) {
+        nodes_[id].on_path = true;
+    }
+
+    // Widgets that are neither under the pointer nor holding any state can't change, so they're skipped
+    next_active_.clear();
+    for (auto id : next_path_) {
+        step(id, pressed);
+    }
+    for (auto id : active_) {
+        step(id, pressed);
+    }
+    std::swap(active_, next_active_);
+
+    for (auto id : path_) {
+        if (!nodes_[id].on_path) {
+            send(EventType::leave, id, point);
+        }
+    }
+    for (auto id : next_path_) {
+        if (std::find(path_.begin(), path_.end(), id) == path_.end()) {
+            send(EventType::enter, id, point);
+        }
+    }
+    std::swap(path_, next_path_);
+
+    auto target = path_.back();
+    if (input.moved()) {
+        bubble(EventType::move, target, point);
+    }
+    if (input.buttons_pressed) {
+        bubble(EventType::down, target, point);
+    }
+    if (input.buttons_released) {
+        bubble(EventType::up, target, point);
+    }
+
+    // A click goes to the deepest widget that completed one
+    for (auto id = path_.rbegin(); id != path_.rend(); ++id) {
+        if (nodes_[*id].widget && nodes_[*id].widget->isClicked()) {
+            bubble(EventType::click, *id, point);
+            break;
+        }
+    }
+    return true;
+}
+
+
+/** Children sit inside their parent, so a dirty node's rects cover its whole subtree */
+auto WidgetTree::collect(NodeId id) -> void {
+    auto const& node = nodes_[id];
+    if (!node.dirty_below) {
+        return;
+    }
+
+    if (node.dirty) {
+        if (!SDL_RectEmpty(&node.drawn)) {
+            damage_.push_back(node.drawn);
+        }
+        if (node.visible && node.widget && !SDL_RectEquals(&node.widget->rect(), &node.drawn)) {
+            damage_.push_back(node.widget->rect());
+        }
+        return;
+    }
+    for (auto child : node.children) {
+        collect(child);
+    }
+}
+
+auto WidgetTree::damage() -> std::vector<SDL_Rect> const& {
+    damage_.clear();
+    if (nodes_[root()].dirty) {
+        damage_.push_back(bounds_);
+    } else {
+        collect(root());
+    }
+    return damage_;
+}
+
+
+auto WidgetTree::render(NodeId id, SDL_Renderer* renderer, SDL_Rect const* clip) -> void {
+    auto& node = nodes_[id];
+    if (!node.visible) {
+        node.drawn = SDL_Rect{0, 0, 0, 0};
+        return;
+    }
+    if (node.widget) {
+        auto const& rect = node.widget->rect();
+        if (clip && !SDL_HasIntersection(&rect, clip)) {
+            return;
+        }
+        node.widget->render(renderer);
+        node.drawn = rect;
+    }
+    for (auto child : node.children) {
+        render(child, renderer, clip);
+    }
+}
+
+auto WidgetTree::clean(NodeId id) -> void {
+    auto& node = nodes_[id];
+    if (!node.dirty_below) {
+        return;
+    }
+    node.dirty       = false;
+    node.dirty_below = false;
+    for (auto child : node.children) {
+        clean(child);
+    }
+}
+
+auto WidgetTree::render(SDL_Renderer* renderer) -> void {
+    if (!dirty()) {
+        return;
+    }
+    PROFILE_ZONE("WidgetTree::render");
+
+    if (nodes_[root()].dirty) {
+        render(root(), renderer, nullptr);
+    } else {
+        for (auto const& rect : damage()) {
+            SDL_RenderSetClipRect(renderer, &rect);
+            render(root(), renderer, &rect);
+        }
+        SDL_RenderSetClipRect(renderer, nullptr);
+    }
+    clean(root());
+}
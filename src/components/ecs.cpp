@@ -0,0 +1,278 @@
+#include <SDL2/SDL.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "components/ecs.hpp"
+
+using std::cout;
+
+namespace ecs {
+    static auto registry_lock = std::mutex{};
+    static auto registry      = std::vector<ComponentInfo>{};
+
+    auto registerComponent(ComponentInfo const& info) -> ComponentId {
+        auto lock = std::lock_guard{registry_lock};
+        if (registry.size() == MAX_COMPONENTS) {
+            // Signatures are 64 bit masks, so there is no way to carry on
+            cout << "ecs: more than " << MAX_COMPONENTS << " component types registered.\n";
+            std::abort();
+        }
+        registry.push_back(info);
+        return static_cast<ComponentId>(registry.size() - 1);
+    }
+
+    auto componentInfo(ComponentId id) -> ComponentInfo const& {
+        auto lock = std::lock_guard{registry_lock};
+        return registry[id];
+    }
+
+    static auto alignUp(std::size_t offset, std::size_t align) -> std::size_t {
+        return (offset + align - 1) / align * align;
+    }
+
+
+    auto Archetype::Chunk::Free::operator()(std::byte* memory) const -> void {
+        ::operator delete(memory, std::align_val_t{CHUNK_ALIGN});
+    }
+
+    /** Lays out the entity array then each component array in a chunk, fitting as many rows as the chunk holds */
+    Archetype::Archetype(Signature signature):  signature_(signature),
+                                                ids_(),
+                                                infos_(),
+                                                column_(),
+                                                offsets_(),
+                                                chunk_bytes_(CHUNK_BYTES),
+                                                capacity_(0),
+                                                chunks_(),
+                                                size_(0) {
+        column_.fill(-1);
+        for (auto id = ComponentId{0}; id < MAX_COMPONENTS; id++) {
+            if (signature_ & (Signature{1} << id)) {
+                column_[id] = static_cast<Sint8>(ids_.size());
+                ids_.push_back(id);
+            }
+        }
+
+        auto row_bytes = sizeof(Entity);
+        for (auto id : ids_) {
+            infos_.push_back(componentInfo(id));
+            row_bytes += infos_.back().size;
+        }
+
+        auto layout = [&](std::size_t rows) {
+            offsets_.clear();
+            auto end = sizeof(Entity) * rows;
+            for (auto const& info : infos_) {
+                auto offset = alignUp(end, info.align);
+                offsets_.push_back(offset);
+                end = offset + info.size * rows;
+            }
+            return end;
+        };
+
+        // Start from the unpadded estimate and back off until the aligned layout fits
+        auto rows = std::max<std::size_t>(1, CHUNK_BYTES / row_bytes);
+        while (rows > 1 && layout(rows) > CHUNK_BYTES) {
+            rows--;
+        }
+        chunk_bytes_ = std::max(CHUNK_BYTES, layout(rows));
+        capacity_    = static_cast<Uint32>(rows);
+    }
+
+    Archetype::~Archetype() {
+        for (auto& chunk : chunks_) {
+            for (auto c = std::size_t{0}; c < ids_.size(); c++) {
+                auto base = chunk.memory.get() + offsets_[c];
+                for (auto row = Uint32{0}; row < chunk.count; row++) {
+                    infos_[c].destroy(base + infos_[c].size * row);
+                }
+            }
+        }
+    }
+
+    auto Archetype::signature() const -> Signature { return signature_; }
+    auto Archetype::size()      const -> std::size_t { return size_; }
+    auto Archetype::capacity()  const -> Uint32 { return capacity_; }
+    auto Archetype::chunks() -> std::vector<Chunk>& { return chunks_; }
+
+    auto Archetype::entities(Chunk const& chunk) const -> Entity* {
+        return reinterpret_cast<Entity*>(chunk.memory.get());
+    }
+
+    auto Archetype::column(Chunk const& chunk, ComponentId id) const -> void* {
+        auto c = static_cast<std::size_t>(column_[id]);
+        return chunk.memory.get() + offsets_[c];
+    }
+
+    auto Archetype::at(Location const& location, ComponentId id) const -> void* {
+        auto c = static_cast<std::size_t>(column_[id]);
+        return chunks_[location.chunk].memory.get() + offsets_[c] + infos_[c].size * location.row;
+    }
+
+    auto Archetype::allocate(Entity entity) -> Location {
+        if (chunks_.empty() || chunks_.back().count == capacity_) {
+            auto memory = static_cast<std::byte*>(::operator new(chunk_bytes_, std::align_val_t{CHUNK_ALIGN}));
+            chunks_.push_back(Chunk{std::unique_ptr<std::byte, Chunk::Free>{memory}, 0});
+        }
+
+        auto& chunk = chunks_.back();
+        auto row    = chunk.count++;
+        entities(chunk)[row] = entity;
+        size_++;
+        return {static_cast<Uint32>(chunks_.size() - 1), row};
+    }
+
+    auto Archetype::release(Location const& location, Signature relocated) -> Entity {
+        auto& chunk = chunks_[location.chunk];
+        auto& last  = chunks_.back();
+        auto  tail  = last.count - 1;
+
+        for (auto c = std::size_t{0}; c < ids_.size(); c++) {
+            auto const& info = infos_[c];
+            auto hole = chunk.memory.get() + offsets_[c] + info.size * location.row;
+
+            if (!(relocated & (Signature{1} << ids_[c]))) {
+                info.destroy(hole);
+            }
+            if (&chunk != &last || location.row != tail) {
+                info.relocate(hole, last.memory.get() + offsets_[c] + info.size * tail);
+            }
+        }
+
+        auto moved = entities(last)[tail];
+        entities(chunk)[location.row] = moved;
+
+        size_--;
+        if (--last.count == 0) {
+            chunks_.pop_back();
+        }
+        return moved;
+    }
+
+
+    World::World(): archetypes_(), by_signature_(), records_(), free_(), size_(0) {}
+
+    auto World::size() const -> std::size_t { return size_; }
+
+    auto World::archetype(Signature signature) -> Archetype* {
+        auto found = by_signature_.find(signature);
+        if (found != by_signature_.end()) {
+            return found->second;
+        }
+        archetypes_.push_back(std::make_unique<Archetype>(signature));
+        by_signature_[signature] = archetypes_.back().get();
+        return archetypes_.back().get();
+    }
+
+    auto World::record(Entity entity) -> Record* {
+        if (entity.index >= records_.size()) {
+            return nullptr;
+        }
+        auto& entry = records_[entity.index];
+        return (entry.archetype && entry.generation == entity.generation) ? &entry : nullptr;
+    }
+
+    auto World::record(Entity entity) const -> Record const* {
+        return const_cast<World*>(this)->record(entity);
+    }
+
+    auto World::alive(Entity entity) const -> bool { return record(entity) != nullptr; }
+
+    /** Reuses a freed slot with its generation already bumped, so stale handles to it stop resolving */
+    auto World::spawn(Signature signature) -> Entity {
+        auto index = Uint32{0};
+        if (!free_.empty()) {
+            index = free_.back();
+            free_.pop_back();
+        } else {
+            index = static_cast<Uint32>(records_.size());
+            records_.push_back(Record{nullptr, {0, 0}, 0});
+        }
+
+        auto& entry  = records_[index];
+        auto entity  = Entity{index, entry.generation};
+        entry.archetype = archetype(signature);
+        entry.location  = entry.archetype->allocate(entity);
+        size_++;
+        return entity;
+    }
+
+    auto World::destroy(Entity entity) -> bool {
+        auto entry = record(entity);
+        if (!entry) {
+            return false;
+        }
+
+        auto moved = entry->archetype->release(entry->location, 0);
+        if (moved != entity) {
+            records_[moved.index].location = entry->location;
+        }
+
+        entry->archetype = nullptr;
+        entry->generation++;
+        free_.push_back(entity.index);
+        size_--;
+        return true;
+    }
+
+    /** Moves the shared components across, anything the new archetype lacks is destroyed with the old row */
+    auto World::migrate(Entity entity, Signature signature) -> void {
+        auto entry = record(entity);
+        auto from  = entry->archetype;
+        auto to    = archetype(signature);
+        if (from == to) {
+            return;
+        }
+
+        auto old_location = entry->location;
+        auto new_location = to->allocate(entity);
+        auto shared       = from->signature() & to->signature();
+        for (auto id = ComponentId{0}; id < MAX_COMPONENTS; id++) {
+            if (shared & (Signature{1} << id)) {
+                componentInfo(id).relocate(to->at(new_location, id), from->at(old_location, id));
+            }
+        }
+
+        auto moved = from->release(old_location, shared);
+        if (moved != entity) {
+            records_[moved.index].location = old_location;
+        }
+        entry->archetype = to;
+        entry->location  = new_location;
+    }
+
+
+    auto renderSprites(World& world, SDL_Renderer* renderer) -> void {
+        PROFILE_FUNCTION();
+
+        world.each<Transform, Sprite>([renderer](Transform& transform, Sprite& sprite) {
+            auto destination = SDL_Rect{static_cast<int>(transform.x) + sprite.clip.x,
+                                        static_cast<int>(transform.y) + sprite.clip.y,
+                                        sprite.clip.w,
+                                        sprite.clip.h};
+            sprite.texture.render(renderer, &destination, transform.angle, nullptr);
+        });
+    }
+
+    /** The shared widget kernel, run over whole chunks of hit boxes at a time */
+    auto updateUI(World& world, InputSnapshot const& input) -> void {
+        PROFILE_FUNCTION();
+
+        auto pressed = input.anyDown();
+        world.eachChunk<Transform, HitBox, UIState>([&input, pressed](Uint32 count, Transform* transforms, HitBox* boxes, UIState* states) {
+            for (auto i = Uint32{0}; i < count; i++) {
+                auto box = SDL_Rect{static_cast<int>(transforms[i].x) + boxes[i].rect.x,
+                                    static_cast<int>(transforms[i].y) + boxes[i].rect.y,
+                                    boxes[i].rect.w,
+                                    boxes[i].rect.h};
+                states[i].state = widget::step(states[i].state, widget::inside(box, input.x, input.y), pressed);
+            }
+        });
+    }
+}  // namespace ecs
@@ -0,0 +1,104 @@
+#include "components/widget.hpp"
+
+WidgetSet::WidgetSet(): x_(), y_(), w_(), h_(), state_() {}
+
+auto WidgetSet::add(SDL_Rect const& rect, widget::State state) -> WidgetId {
+    x_.push_back(rect.x);
+    y_.push_back(rect.y);
+    w_.push_back(rect.w);
+    h_.push_back(rect.h);
+    state_.push_back(state);
+    return static_cast<WidgetId>(state_.size() - 1);
+}
+
+auto WidgetSet::clear() -> void {
+    x_.clear();
+    y_.clear();
+    w_.clear();
+    h_.clear();
+    state_.clear();
+}
+
+auto WidgetSet::size() const -> std::size_t { return state_.size(); }
+
+auto WidgetSet::rect(WidgetId id) const -> SDL_Rect { return {x_[id], y_[id], w_[id], h_[id]}; }
+
+auto WidgetSet::setRect(WidgetId id, SDL_Rect const& rect) -> void {
+    x_[id] = rect.x;
+    y_[id] = rect.y;
+    w_[id] = rect.w;
+    h_[id] = rect.h;
+}
+
+auto WidgetSet::state(WidgetId id)      const -> widget::State { return state_[id]; }
+auto WidgetSet::isHovering(WidgetId id) const -> bool { return state_[id] & widget::HOVERING; }
+auto WidgetSet::isClicking(WidgetId id) const -> bool { return state_[id] & widget::CLICKING; }
+auto WidgetSet::isClicked(WidgetId id)  const -> bool { return state_[id] & widget::CLICKED; }
+
+auto WidgetSet::advance(WidgetId id, bool inside, bool pressed) -> bool {
+    auto previous = state_[id];
+    state_[id] = widget::step(previous, inside, pressed);
+    return state_[id] != previous;
+}
+
+auto WidgetSet::update() -> bool {
+    return step(mouse::x(), mouse::y(), mouse::pressed());
+}
+
+auto WidgetSet::update(InputSnapshot const& input) -> bool {
+    return step(input.x, input.y, input.anyDown());
+}
+
+/** Plain arrays and a branch free body, so the compiler is free to vectorise the loop */
+auto WidgetSet::step(int x, int y, bool pressed) -> bool {
+    PROFILE_ZONE("WidgetSet::update");
+
+    auto count = state_.size();
+    auto xs    = x_.data();
+    auto ys    = y_.data();
+    auto ws    = w_.data();
+    auto hs    = h_.data();
+    auto state = state_.data();
+    auto held  = widget::State{0};
+
+    for (auto i = std::size_t{0}; i < count; i++) {
+        auto inside = (x > xs[i]) & (x < xs[i] + ws[i]) & (y > ys[i]) & (y < ys[i] + hs[i]);
+        state[i] = widget::step(state[i], inside, pressed);
+        held |= state[i];
+    }
+    return held & widget::CLICKED;
+}
+
+
+WidgetSlot::WidgetSlot(): set_(nullptr), id_(0), state_(0) {}
+
+auto WidgetSlot::attach(WidgetSet& set, SDL_Rect const& rect) -> void {
+    detach();
+    id_  = set.add(rect, state_);
+    set_ = &set;
+}
+
+auto WidgetSlot::detach() -> void {
+    if (set_) {
+        state_ = set_->state(id_);
+        set_->setRect(id_, {0, 0, 0, 0});
+        set_ = nullptr;
+    }
+}
+
+auto WidgetSlot::state() const -> widget::State { return set_ ? set_->state(id_) : state_; }
+
+auto WidgetSlot::advance(bool inside, bool pressed) -> bool {
+    if (set_) {
+        return set_->advance(id_, inside, pressed);
+    }
+    auto previous = state_;
+    state_ = widget::step(state_, inside, pressed);
+    return state_ != previous;
+}
+
+auto WidgetSlot::setRect(SDL_Rect const& rect) -> void {
+    if (set_) {
+        set_->setRect(id_, rect);
+    }
+}
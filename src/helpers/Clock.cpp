@@ -0,0 +1,134 @@
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+
+#include "helpers/Clock.hpp"
+#include "helpers/replay.hpp"
+
+static const auto NS_PER_SECOND = Uint64{1'000'000'000};
+static const auto NS_PER_MS     = Uint64{1'000'000};
+
+
+auto Clock::real() -> Clock& {
+    static auto clock = RealClock{};
+    return clock;
+}
+
+auto Clock::precise() const -> bool { return false; }
+auto Clock::paused()  const -> bool { return false; }
+
+auto Clock::ticks() -> Uint32 {
+    return static_cast<Uint32>(nanos() / NS_PER_MS);
+}
+
+
+RealClock::RealClock(): frequency_(SDL_GetPerformanceFrequency()), base_(SDL_GetPerformanceCounter()) {}
+
+auto RealClock::nanos() -> Uint64 {
+    // Split the conversion so counter * 1e9 can't overflow on high resolution counters
+    auto counter = SDL_GetPerformanceCounter() - base_;
+    return (counter / frequency_) * NS_PER_SECOND + ((counter % frequency_) * NS_PER_SECOND) / frequency_;
+}
+
+auto RealClock::sleepUntil(Uint64 target) -> void {
+    auto time = nanos();
+    if (target > time) {
+        SDL_Delay(static_cast<Uint32>((target - time) / NS_PER_MS));
+    }
+}
+
+auto RealClock::precise() const -> bool { return true; }
+
+/**
+ * Wall time goes through the recorder, so replays see the same times the recording did. Scaled clocks
+ * get there by reading their parent's ticks, manual clocks only move when stepped.
+ */
+auto RealClock::ticks() -> Uint32 {
+    return replay::observeTicks(Clock::ticks());
+}
+
+
+ScaledClock::ScaledClock(Clock& parent, double scale):  parent_(&parent),
+                                                        scale_(std::max(scale, 0.0)),
+                                                        resume_scale_(scale_),
+                                                        recorded_base_(replay::mode() != replay::Mode::off),
+                                                        parent_base_(0),
+                                                        base_(0),
+                                                        last_(0) {
+    parent_base_ = parentNanos();
+}
+
+/**
+ * nanos() on a real parent would bypass the recorder and desync replays, so its ticks are read instead
+ * while one is running. Readings from the two paths don't line up, so switching between them rebases.
+ */
+auto ScaledClock::parentNanos() -> Uint64 {
+    auto recorded = replay::mode() != replay::Mode::off;
+    auto time     = recorded ? Uint64{parent_->ticks()} * NS_PER_MS : parent_->nanos();
+    if (recorded != recorded_base_) {
+        recorded_base_ = recorded;
+        parent_base_   = time;
+        base_          = last_;
+    }
+    return time;
+}
+
+auto ScaledClock::elapsed(Uint64 parent) const -> Uint64 {
+    auto delta = parent > parent_base_ ? parent - parent_base_ : 0;
+    return base_ + static_cast<Uint64>(static_cast<double>(delta) * scale_);
+}
+
+auto ScaledClock::scale()  const -> double { return scale_; }
+auto ScaledClock::paused() const -> bool   { return scale_ == 0.0 || parent_->paused(); }
+
+/** Rebases on every change so time already elapsed keeps the scale it passed at */
+auto ScaledClock::setScale(double scale) -> void {
+    auto parent  = parentNanos();
+    base_        = elapsed(parent);
+    parent_base_ = parent;
+    scale_       = std::max(scale, 0.0);
+}
+
+auto ScaledClock::pause() -> void {
+    if (scale_ > 0.0) {
+        resume_scale_ = scale_;
+        setScale(0.0);
+    }
+}
+
+auto ScaledClock::resume() -> void {
+    if (scale_ == 0.0) {
+        setScale(resume_scale_);
+    }
+}
+
+auto ScaledClock::nanos() -> Uint64 {
+    last_ = elapsed(parentNanos());
+    return last_;
+}
+
+/** A paused clock can't reach the target, so it returns immediately */
+auto ScaledClock::sleepUntil(Uint64 target) -> void {
+    auto time = nanos();
+    if (target > time && scale_ > 0.0) {
+        parent_->sleepUntil(parent_->nanos() + static_cast<Uint64>(static_cast<double>(target - time) / scale_));
+    }
+}
+
+/** Sleeps on the parent, so undershoots like it. Not while recording, where every spin would be a tick record. */
+auto ScaledClock::precise() const -> bool {
+    return parent_->precise() && replay::mode() == replay::Mode::off;
+}
+
+
+ManualClock::ManualClock(Uint64 start): now_(start) {}
+
+auto ManualClock::set(Uint64 ns)     -> void { now_ = ns; }
+auto ManualClock::step(Uint64 ns)    -> void { now_ += ns; }
+auto ManualClock::stepMs(Uint32 ms)  -> void { now_ += ms * NS_PER_MS; }
+
+auto ManualClock::nanos() -> Uint64 { return now_; }
+
+auto ManualClock::sleepUntil(Uint64 target) -> void {
+    now_ = std::max(now_, target);
+}
@@ -0,0 +1,203 @@
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "helpers/EventDispatcher.hpp"
+#include "helpers/replay.hpp"
+
+
+EventDispatcher::EventDispatcher():     table_(),
+                                        keys_(),
+                                        any_(),
+                                        owners_(),
+                                        pending_(),
+                                        batch_(),
+                                        motion_(false),
+                                        next_id_(1),
+                                        dispatching_(false),
+                                        removed_(false),
+                                        frame_subscriptions_(false),
+                                        coalesce_motion_(false) {}
+
+
+auto EventDispatcher::list(Uint32 type) -> HandlerList& {
+    auto& page = table_[(type >> 8) & 0xFF];
+    if (!page) {
+        page = std::make_unique<Page>();
+    }
+    return (*page)[type & 0xFF];
+}
+
+auto EventDispatcher::find(Uint32 type) const -> HandlerList const* {
+    auto const& page = table_[(type >> 8) & 0xFF];
+    return page ? &(*page)[type & 0xFF] : nullptr;
+}
+
+/** Handlers added while dispatching are held back so a running handler is never moved */
+auto EventDispatcher::add(HandlerList& list, Handler&& handler, bool frame_only) -> HandlerId {
+    auto id    = next_id_++;
+    auto entry = Entry{id, std::move(handler), frame_only, false};
+
+    if (dispatching_) {
+        pending_.emplace_back(&list, std::move(entry));
+    } else {
+        list.push_back(std::move(entry));
+    }
+    owners_[id] = &list;
+    frame_subscriptions_ = frame_subscriptions_ || frame_only;
+    return id;
+}
+
+
+auto EventDispatcher::on(Uint32 type, Handler handler)        -> HandlerId { return add(list(type), std::move(handler), false); }
+auto EventDispatcher::onKey(SDL_Keycode key, Handler handler) -> HandlerId { return add(keys_[key], std::move(handler), false); }
+auto EventDispatcher::onAny(Handler handler)                  -> HandlerId { return add(any_, std::move(handler), false); }
+
+/** Subscribes for the next dispatch() only */
+auto EventDispatcher::onFrame(Uint32 type, Handler handler)   -> HandlerId { return add(list(type), std::move(handler), true); }
+
+auto EventDispatcher::off(HandlerId id) -> bool {
+    auto owner = owners_.find(id);
+    if (owner == owners_.end()) {
+        return false;
+    }
+
+    for (auto& entry : *owner->second) {
+        if (entry.id == id) { entry.removed = true; }
+    }
+    for (auto& [list, entry] : pending_) {
+        if (entry.id == id) { entry.removed = true; }
+    }
+
+    owners_.erase(owner);
+    removed_ = true;
+    if (!dispatching_) {
+        flush(false);
+    }
+    return true;
+}
+
+
+auto EventDispatcher::coalesceMotion(bool enabled, bool keep_path) -> void {
+    coalesce_motion_ = enabled;
+    motion_.keepPath(enabled && keep_path);
+}
+
+auto EventDispatcher::motionPath() const -> std::vector<SDL_MouseMotionEvent> const& { return motion_.path(); }
+
+
+auto EventDispatcher::invoke(HandlerList& list, SDL_Event const& event) -> void {
+    for (auto& entry : list) {
+        if (!entry.removed) {
+            entry.handler(event);
+        }
+    }
+}
+
+auto EventDispatcher::route(SDL_Event const& event) -> void {
+    auto was_dispatching = dispatching_;
+    dispatching_ = true;
+
+    invoke(any_, event);
+
+    auto page = table_[(event.type >> 8) & 0xFF].get();
+    if (page) {
+        invoke((*page)[event.type & 0xFF], event);
+    }
+
+    if (event.type == SDL_KEYDOWN && !keys_.empty()) {
+        auto key = keys_.find(event.key.keysym.sym);
+        if (key != keys_.end()) {
+            invoke(key->second, event);
+        }
+    }
+
+    dispatching_ = was_dispatching;
+    if (!dispatching_) {
+        flush(false);
+    }
+}
+
+/** Drops removed handlers, and per-frame subscriptions at the end of a frame, then applies deferred additions */
+auto EventDispatcher::flush(bool end_of_frame) -> void {
+    // Only walk the table when something was removed or a per-frame subscription is due to expire
+    if (removed_ || (end_of_frame && frame_subscriptions_)) {
+        auto prune = [this, end_of_frame](HandlerList& list) {
+            list.erase(std::remove_if(list.begin(), list.end(), [this, end_of_frame](Entry const& entry) {
+                if (end_of_frame && entry.frame_only && !entry.removed) {
+                    owners_.erase(entry.id);
+                    return true;
+                }
+                return entry.removed;
+            }), list.end());
+        };
+
+        prune(any_);
+        for (auto& [key, list] : keys_) {
+            prune(list);
+        }
+        for (auto& page : table_) {
+            if (page) {
+                for (auto& list : *page) {
+                    prune(list);
+                }
+            }
+        }
+
+        removed_ = false;
+        if (end_of_frame) {
+            frame_subscriptions_ = false;
+        }
+    }
+
+    // Subscriptions made during a frame start with the next one
+    for (auto& [list, entry] : pending_) {
+        if (!entry.removed) {
+            frame_subscriptions_ = frame_subscriptions_ || entry.frame_only;
+            list->push_back(std::move(entry));
+        }
+    }
+    pending_.clear();
+}
+
+
+auto EventDispatcher::deliver(SDL_Event const& event) -> void {
+    if (coalesce_motion_) {
+        motion_.feed(event, [this](SDL_Event const& merged) { route(merged); });
+    } else {
+        route(event);
+    }
+}
+
+/** Routes everything currently queued, returns the number of events taken off the queue */
+auto EventDispatcher::dispatch() -> int {
+    auto handled = 0;
+    dispatching_ = true;
+    motion_.beginFrame();
+
+    if (replay::mode() != replay::Mode::off) {
+        // The recorder works one event at a time so it can mark where each frame's events end
+        auto event = SDL_Event{};
+        while (replay::pollEvent(&event)) {
+            deliver(event);
+            handled++;
+        }
+    } else {
+        SDL_PumpEvents();
+        auto count = BATCH_SIZE;
+        while (count == BATCH_SIZE) {
+            count = SDL_PeepEvents(batch_.data(), BATCH_SIZE, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+            for (auto i = 0; i < count; i++) {
+                deliver(batch_[static_cast<std::size_t>(i)]);
+            }
+            handled += std::max(count, 0);
+        }
+    }
+
+    motion_.flush([this](SDL_Event const& merged) { route(merged); });
+
+    dispatching_ = false;
+    flush(true);
+    return handled;
+}
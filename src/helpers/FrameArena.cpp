@@ -0,0 +1,106 @@
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <new>
+
+#include "helpers/FrameArena.hpp"
+
+
+FrameArena::FrameArena(std::size_t capacity): blocks_(),
+                                              offset_(0),
+                                              used_(0),
+                                              peak_(0),
+                                              upstream_(0),
+                                              frame_upstream_(0) {
+    grow(capacity, alignof(std::max_align_t));
+    frame_upstream_ = 0;
+}
+
+FrameArena::~FrameArena() { freeBlocks(); }
+
+auto FrameArena::freeBlocks() -> void {
+    for (auto const& block : blocks_) {
+        ::operator delete(block.data, std::align_val_t{alignof(std::max_align_t)});
+    }
+    blocks_.clear();
+}
+
+/** New blocks at least double, so a frame that keeps overflowing only goes upstream a handful of times */
+auto FrameArena::grow(std::size_t bytes, std::size_t alignment) -> void {
+    auto last = blocks_.empty() ? std::size_t{0} : blocks_.back().size;
+    auto size = std::max(bytes + alignment, last * 2);
+    blocks_.push_back(Block{static_cast<std::byte*>(::operator new(size, std::align_val_t{alignof(std::max_align_t)})), size});
+    offset_ = 0;
+    upstream_++;
+    frame_upstream_++;
+}
+
+auto FrameArena::do_allocate(std::size_t bytes, std::size_t alignment) -> void* {
+    auto address = reinterpret_cast<std::uintptr_t>(blocks_.back().data) + offset_;
+    auto padding = (alignment - address % alignment) % alignment;
+    if (offset_ + padding + bytes > blocks_.back().size) {
+        grow(bytes, alignment);
+        address = reinterpret_cast<std::uintptr_t>(blocks_.back().data);
+        padding = (alignment - address % alignment) % alignment;
+    }
+
+    offset_ += padding + bytes;
+    used_   += padding + bytes;
+    return blocks_.back().data + offset_ - bytes;
+}
+
+auto FrameArena::do_deallocate(void*, std::size_t, std::size_t) -> void {}
+
+auto FrameArena::do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool { return this == &other; }
+
+
+auto FrameArena::reset() -> Uint64 {
+    peak_ = std::max(peak_, used_);
+    auto frame_upstream = frame_upstream_;
+
+    // Replace an overflowed chain with one block that fits the whole peak
+    if (blocks_.size() > 1) {
+        auto total = capacity();
+        freeBlocks();
+        grow(std::max(total, peak_), alignof(std::max_align_t));
+    }
+
+    offset_         = 0;
+    used_           = 0;
+    frame_upstream_ = 0;
+    return frame_upstream;
+}
+
+auto FrameArena::used() const -> std::size_t { return used_; }
+auto FrameArena::peak() const -> std::size_t { return std::max(peak_, used_); }
+auto FrameArena::upstreamAllocations() const -> Uint64 { return upstream_; }
+
+auto FrameArena::capacity() const -> std::size_t {
+    auto total = std::size_t{0};
+    for (auto const& block : blocks_) {
+        total += block.size;
+    }
+    return total;
+}
+
+auto FrameArena::format(char const* fmt, ...) -> std::string_view {
+    std::va_list args;
+    va_start(args, fmt);
+    std::va_list copy;
+    va_copy(copy, args);
+    auto length = std::vsnprintf(nullptr, 0, fmt, copy);
+    va_end(copy);
+
+    if (length < 0) {
+        va_end(args);
+        return {};
+    }
+
+    auto text = static_cast<char*>(allocate(static_cast<std::size_t>(length) + 1, 1));
+    std::vsnprintf(text, static_cast<std::size_t>(length) + 1, fmt, args);
+    va_end(args);
+    return {text, static_cast<std::size_t>(length)};
+}
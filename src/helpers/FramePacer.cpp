@@ -0,0 +1,112 @@
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <thread> // NOLINT [build/c++11]
+
+#include "helpers/FramePacer.hpp"
+#include "helpers/replay.hpp"
+
+/** Real time in nanoseconds, for measurements that must not follow a scaled or stepped clock */
+auto FramePacer::now() -> Uint64 {
+    return Clock::real().nanos();
+}
+
+
+FramePacer::FramePacer(Uint64 period_ns, Uint64 spin_ns, Clock& clock):    clock_(&clock),
+                                                                            period_ns_(std::max(period_ns, Uint64{1})),
+                                                                            spin_ns_(std::min(spin_ns, period_ns_)),
+                                                                            base_spin_ns_(spin_ns_),
+                                                                            oversleep_ns_(0),
+                                                                            deadline_(0),
+                                                                            last_wake_(0),
+                                                                            frame_time_(0),
+                                                                            missed_(0),
+                                                                            missed_last_(false) {
+    reset();
+}
+
+FramePacer::FramePacer(Uint64 period_ns, Clock& clock): FramePacer(period_ns, 2'000'000, clock) {}
+
+auto FramePacer::clock() -> Clock& { return *clock_; }
+
+auto FramePacer::period()     const -> Uint64 { return period_ns_; }
+auto FramePacer::spin()       const -> Uint64 { return spin_ns_; }
+auto FramePacer::frameTime()  const -> Uint64 { return frame_time_; }
+auto FramePacer::missed()     const -> Uint64 { return missed_; }
+auto FramePacer::missedLast() const -> bool   { return missed_last_; }
+
+auto FramePacer::setPeriod(Uint64 period_ns) -> void {
+    period_ns_    = std::max(period_ns, Uint64{1});
+    spin_ns_      = std::min(spin_ns_, period_ns_);
+    base_spin_ns_ = std::min(base_spin_ns_, period_ns_);
+}
+
+
+auto FramePacer::wait() -> bool {
+    // Deadlines are scheduled from the previous deadline rather than the wake time, so
+    // any oversleep is paid back by the next frame instead of accumulating as drift.
+    deadline_ += period_ns_;
+
+    auto time = clock_->nanos();
+
+    if (replay::mode() == replay::Mode::replay) {
+        // Replays run flat out, the recorded ticks already carry the session's timing
+        deadline_ = time;
+    } else if (clock_->paused()) {
+        // A paused clock's sleepUntil returns at once, so wait out the period in real time instead of
+        // spinning, and hold the deadline where the clock stopped so resuming doesn't stall for the pause
+        auto& real = Clock::real();
+        real.sleepUntil(real.nanos() + period_ns_);
+        deadline_ = time;
+    } else if (time < deadline_ && !clock_->precise()) {
+        // Stepped clocks have no sleep jitter to spin out, and scaled ones mustn't spin while recording
+        clock_->sleepUntil(deadline_);
+        time = clock_->nanos();
+    } else if (time < deadline_) {
+        auto remaining = deadline_ - time;
+        auto oversleep = Uint64{0};
+        if (remaining > spin_ns_) {
+            auto target = deadline_ - spin_ns_;
+            clock_->sleepUntil(target);
+
+            time      = clock_->nanos();
+            oversleep = time > target ? time - target : 0;
+        }
+
+        // Keep a running average of how late the OS wakes us, jumping straight to any oversleep that blew
+        // through the deadline, and spin for twice that. Frames that only spun count as waking on time, so
+        // the window shrinks back to what we were configured with once the OS settles down.
+        oversleep_ns_ = time > deadline_ ? std::max(oversleep_ns_, oversleep)
+                                         : oversleep_ns_ - oversleep_ns_ / 8 + oversleep / 8;
+        spin_ns_      = std::clamp(oversleep_ns_ * 2, base_spin_ns_, period_ns_);
+
+        while (clock_->nanos() < deadline_) {
+            std::this_thread::yield();
+        }
+    }
+
+    // Judged on the wake time rather than before sleeping, so a sleep that overshot the deadline is a miss
+    // too. The spin always ends a hair past the deadline, so it doesn't count.
+    missed_last_ = time > deadline_;
+    if (missed_last_) {
+        missed_++;
+        // More than a whole period behind: drop the lost frames instead of bursting to catch up
+        if (time - deadline_ >= period_ns_) {
+            deadline_ = time;
+        }
+    }
+
+    time        = clock_->nanos();
+    frame_time_ = time - last_wake_;
+    last_wake_  = time;
+
+    return !missed_last_;
+}
+
+auto FramePacer::reset() -> void {
+    deadline_    = clock_->nanos();
+    last_wake_   = deadline_;
+    frame_time_  = 0;
+    missed_      = 0;
+    missed_last_ = false;
+}
@@ -0,0 +1,151 @@
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+#include "helpers/FrameStats.hpp"
+#include "helpers/FramePacer.hpp"
+
+using std::cout;
+
+
+FrameStats::FrameStats(std::size_t window):     samples_(std::max(window, std::size_t{1})),
+                                                scratch_(),
+                                                next_(0),
+                                                count_(0),
+                                                frame_begin_(0),
+                                                present_begin_(0),
+                                                current_({0, 0, 0}),
+                                                in_frame_(false) {
+    scratch_.reserve(samples_.size());
+}
+
+auto FrameStats::window() const -> std::size_t { return samples_.size(); }
+auto FrameStats::size()   const -> std::size_t { return count_; }
+
+/** Age 0 is the most recently recorded frame */
+auto FrameStats::sample(std::size_t age) const -> FrameSample const& {
+    return samples_[(next_ + samples_.size() - 1 - age) % samples_.size()];
+}
+
+
+auto FrameStats::beginFrame() -> void {
+    auto time = FramePacer::now();
+
+    // A frame spans from one beginFrame to the next, so pacing and vsync waits land in total
+    if (in_frame_) {
+        current_.total = time - frame_begin_;
+        record(current_);
+    }
+
+    frame_begin_   = time;
+    present_begin_ = time;
+    current_       = {0, 0, 0};
+    in_frame_      = true;
+}
+
+auto FrameStats::beginPresent() -> void {
+    present_begin_ = FramePacer::now();
+    current_.cpu   = present_begin_ - frame_begin_;
+}
+
+auto FrameStats::endPresent() -> void {
+    current_.present = FramePacer::now() - present_begin_;
+}
+
+auto FrameStats::record(FrameSample const& sample) -> void {
+    samples_[next_] = sample;
+    next_  = (next_ + 1) % samples_.size();
+    count_ = std::min(count_ + 1, samples_.size());
+}
+
+auto FrameStats::clear() -> void {
+    next_     = 0;
+    count_    = 0;
+    in_frame_ = false;
+}
+
+
+auto FrameStats::summarize(Uint64 FrameSample::* channel) const -> FrameSummary {
+    if (count_ == 0) {
+        return {0, 0, 0, 0, 0, 0};
+    }
+
+    scratch_.clear();
+    auto sum = Uint64{0};
+    for (auto i = std::size_t{0}; i < count_; i++) {
+        scratch_.push_back(samples_[i].*channel);
+        sum += samples_[i].*channel;
+    }
+
+    // Nearest-rank percentiles. Each nth_element only reorders the tail left by the previous
+    // one, so values are read out before the next pass can move them.
+    auto rank = [this](unsigned percent) {
+        return scratch_.begin() + static_cast<std::ptrdiff_t>(std::min(count_ - 1, (count_ * percent + 99) / 100 - 1));
+    };
+    auto p50 = rank(50);
+    auto p95 = rank(95);
+    auto p99 = rank(99);
+
+    auto summary = FrameSummary{};
+    summary.mean = sum / count_;
+
+    std::nth_element(scratch_.begin(), p50, scratch_.end());
+    summary.p50 = *p50;
+    summary.min = *std::min_element(scratch_.begin(), p50 + 1);
+
+    std::nth_element(p50, p95, scratch_.end());
+    summary.p95 = *p95;
+
+    std::nth_element(p95, p99, scratch_.end());
+    summary.p99 = *p99;
+    summary.max = *std::max_element(p99, scratch_.end());
+
+    return summary;
+}
+
+auto FrameStats::cpu()     const -> FrameSummary { return summarize(&FrameSample::cpu); }
+auto FrameStats::present() const -> FrameSummary { return summarize(&FrameSample::present); }
+auto FrameStats::total()   const -> FrameSummary { return summarize(&FrameSample::total); }
+
+
+/** Buckets total frame time, the last bucket collects everything past the end of the range */
+auto FrameStats::histogram(Uint64 bucket_ns, std::size_t buckets) const -> std::vector<std::size_t> {
+    auto result = std::vector<std::size_t>(std::max(buckets, std::size_t{1}), 0);
+    bucket_ns   = std::max(bucket_ns, Uint64{1});
+
+    for (auto i = std::size_t{0}; i < count_; i++) {
+        auto bucket = std::min(static_cast<std::size_t>(samples_[i].total / bucket_ns), result.size() - 1);
+        result[bucket]++;
+    }
+
+    return result;
+}
+
+
+auto FrameStats::dump(char const* file_name) const -> bool {
+    auto file = std::ofstream{file_name};
+    if (!file) {
+        cout << "Unable to open " << file_name << " for frame statistics.\n";
+        return false;
+    }
+
+    auto write_summary = [&file](char const* name, FrameSummary const& s) {
+        file << "# " << name << " min=" << s.min << " mean=" << s.mean << " p50=" << s.p50
+             << " p95=" << s.p95 << " p99=" << s.p99 << " max=" << s.max << "\n";
+    };
+
+    file << "# frames=" << count_ << " (times in ns)\n";
+    write_summary("cpu",     cpu());
+    write_summary("present", present());
+    write_summary("total",   total());
+
+    file << "cpu,present,total\n";
+    for (auto age = count_; age > 0; age--) {
+        auto const& s = sample(age - 1);
+        file << s.cpu << "," << s.present << "," << s.total << "\n";
+    }
+
+    return static_cast<bool>(file);
+}
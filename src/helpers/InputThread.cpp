@@ -0,0 +1,181 @@
+#include <SDL2/SDL.h>
+
+#include <chrono>  // NOLINT [build/c++11]
+#include <cstring>
+#include <mutex>   // NOLINT [build/c++11]
+#include <thread>  // NOLINT [build/c++11]
+
+#include "helpers/InputThread.hpp"
+#include "helpers/replay.hpp"
+
+
+InputThread::InputThread(std::chrono::microseconds interval):   queue_(),
+                                                                pump_(),
+                                                                running_(false),
+                                                                producer_(0),
+                                                                spill_mutex_(),
+                                                                spilled_(),
+                                                                spilling_(false),
+                                                                interval_(interval),
+                                                                previous_filter_(nullptr),
+                                                                previous_userdata_(nullptr),
+                                                                started_(false),
+                                                                threaded_(false) {}
+
+InputThread::~InputThread() {
+    stop();
+}
+
+
+auto InputThread::threadingSupported() -> bool {
+    auto driver = SDL_GetCurrentVideoDriver();
+    return driver && std::strcmp(driver, "dummy") == 0;
+}
+
+/**
+ * Runs on whichever thread pushed the event, and always takes it out of SDL's queue. Only the producer
+ * may write to the ring; anything else, or anything that doesn't fit, is spilled. Once one event spills
+ * everything after it spills too until the consumer has drained them, and the flag only changes under
+ * the spill lock, so events are always handed out in the order they arrived.
+ */
+auto InputThread::filter(void* userdata, SDL_Event* event) -> int {
+    auto self = static_cast<InputThread*>(userdata);
+
+    if (self->previous_filter_ && self->previous_filter_(self->previous_userdata_, event) == 0) {
+        return 0;
+    }
+
+    auto timed = TimedEvent{*event, SDL_GetPerformanceCounter()};
+    if (!self->spilling_.load(std::memory_order_acquire) &&
+        SDL_ThreadID() == self->producer_.load(std::memory_order_acquire) &&
+        self->queue_.push(timed)) {
+        return 0;
+    }
+
+    auto lock = std::scoped_lock{self->spill_mutex_};
+    self->spilled_.push_back(timed);
+    self->spilling_.store(true, std::memory_order_release);
+    return 0;
+}
+
+
+/** Installing the filter makes SDL drop whatever was already queued, so start before the loop begins */
+auto InputThread::start(bool threaded) -> bool {
+    if (started_) {
+        return true;
+    }
+    started_ = true;
+
+    // Recording has to see every event go through replay::pollEvent, so input stays on the polling path
+    if (replay::mode() != replay::Mode::off) {
+        threaded_ = false;
+        return true;
+    }
+
+    SDL_GetEventFilter(&previous_filter_, &previous_userdata_);
+    threaded_ = threaded && threadingSupported();
+
+    if (!threaded_) {
+        producer_.store(SDL_ThreadID(), std::memory_order_release);
+        SDL_SetEventFilter(filter, this);
+        return true;
+    }
+
+    running_.store(true, std::memory_order_release);
+    SDL_SetEventFilter(filter, this);
+    pump_ = std::thread([this]() {
+        producer_.store(SDL_ThreadID(), std::memory_order_release);
+        while (running_.load(std::memory_order_acquire)) {
+            SDL_PumpEvents();
+            std::this_thread::sleep_for(interval_);
+        }
+    });
+    return true;
+}
+
+auto InputThread::stop() -> void {
+    if (!started_) {
+        return;
+    }
+    started_ = false;
+
+    running_.store(false, std::memory_order_release);
+    if (pump_.joinable()) {
+        pump_.join();
+    }
+
+    if (replay::mode() == replay::Mode::off) {
+        SDL_SetEventFilter(previous_filter_, previous_userdata_);
+
+        // Hand anything not yet polled back to SDL so it isn't lost with the filter
+        auto timed = TimedEvent{};
+        while (queue_.pop(&timed) || takeSpilled(&timed)) {
+            SDL_PushEvent(&timed.event);
+        }
+    }
+    producer_.store(0, std::memory_order_release);
+    threaded_ = false;
+}
+
+auto InputThread::threaded() const -> bool { return threaded_; }
+
+
+auto InputThread::pump() -> void {
+    if (!threaded_) {
+        SDL_PumpEvents();
+    }
+}
+
+
+/** Only called with the ring empty. Spilling ends under the lock the filter spills under, so nothing slips past */
+auto InputThread::takeSpilled(TimedEvent* out, Uint64 until) -> bool {
+    if (!spilling_.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    auto lock = std::scoped_lock{spill_mutex_};
+    if (spilled_.empty()) {
+        spilling_.store(false, std::memory_order_release);
+        return false;
+    }
+    if (spilled_.front().counter > until) {
+        return false;
+    }
+    *out = spilled_.front();
+    spilled_.pop_front();
+    return true;
+}
+
+/** Behaves like SDL_PollEvent, pumping first when nothing else will and the ring has run dry */
+auto InputThread::poll(TimedEvent* out) -> bool {
+    if (!started_ || replay::mode() != replay::Mode::off) {
+        if (replay::pollEvent(&out->event) == 0) {
+            return false;
+        }
+        out->counter = SDL_GetPerformanceCounter();
+        return true;
+    }
+
+    if (!threaded_ && queue_.empty()) {
+        SDL_PumpEvents();
+    }
+
+    // Everything in the ring arrived before the first spilled event, so the ring always drains first
+    return queue_.pop(out) || takeSpilled(out);
+}
+
+auto InputThread::pollUntil(Uint64 counter, TimedEvent* out) -> bool {
+    if (!started_ || replay::mode() != replay::Mode::off) {
+        return poll(out);
+    }
+
+    if (auto next = queue_.front()) {
+        if (next->counter > counter) {
+            return false;
+        }
+        *out = *next;
+        queue_.pop();
+        return true;
+    }
+    return takeSpilled(out, counter);
+}
@@ -9,6 +9,7 @@
 #include <iostream>
 
 #include "helpers/ManagedSDLTexture.hpp"
+#include "helpers/Profiler.hpp"
 
 
 ManagedSDLTexture::ManagedSDLTexture(): ManagedResource() {}
@@ -43,6 +44,9 @@ auto ManagedSDLTexture::rect() const -> SDL_Rect const& { return src_clip_; }
 auto ManagedSDLTexture::pos() const -> SDL_Point { return {src_clip_.x, src_clip_.y}; }
 auto ManagedSDLTexture::dim() const -> SDL_Point { return {src_clip_.w, src_clip_.h}; }
 
+auto ManagedSDLTexture::view() const -> TextureView { return TextureView{*this, src_clip_}; }
+auto ManagedSDLTexture::view(SDL_Rect const& source_clip) const -> TextureView { return TextureView{*this, source_clip}; }
+
 auto ManagedSDLTexture::setClip(SDL_Rect const& rect) -> ManagedSDLTexture& { src_clip_ = rect; return *this; }
 auto ManagedSDLTexture::setClipPos(SDL_Point const& pos) -> ManagedSDLTexture& { src_clip_.x = pos.x; src_clip_.y = pos.y; return *this; }
 auto ManagedSDLTexture::setClipDim(SDL_Point const& dim) -> ManagedSDLTexture& { src_clip_.w = dim.x; src_clip_.h = dim.y; return *this; }
@@ -67,6 +71,7 @@ auto ManagedSDLTexture::render(SDL_Renderer* renderer,
                                double angle,
                                SDL_Point* center,
                                SDL_RendererFlip flip) -> void {
+    PROFILE_ZONE("ManagedSDLTexture::render");
     SDL_RenderCopyEx(renderer, *this, &src_clip_, clip, angle, center, flip);
 }
 auto ManagedSDLTexture::render(SDL_Renderer* renderer, SDL_Rect* clip, SDL_RendererFlip flip) -> void {
@@ -0,0 +1,45 @@
+#include <SDL2/SDL.h>
+
+#include <vector>
+
+#include "helpers/MotionCoalescer.hpp"
+
+
+MotionCoalescer::MotionCoalescer(bool keep_path):   pending_(),
+                                                    has_pending_(false),
+                                                    keep_path_(keep_path),
+                                                    merged_(0),
+                                                    path_() {}
+
+
+/** Keeps the path's capacity, so after the first busy frame recording it doesn't allocate */
+auto MotionCoalescer::beginFrame() -> void {
+    path_.clear();
+    merged_ = 0;
+}
+
+auto MotionCoalescer::path() const -> std::vector<SDL_MouseMotionEvent> const& { return path_; }
+auto MotionCoalescer::merged() const -> int { return merged_; }
+
+auto MotionCoalescer::keepPath(bool keep) -> void {
+    keep_path_ = keep;
+    if (!keep_path_) {
+        path_.clear();
+    }
+}
+
+
+auto MotionCoalescer::merge(SDL_MouseMotionEvent const& motion) -> bool {
+    auto& run = pending_.motion;
+    if (run.windowID != motion.windowID || run.which != motion.which || run.state != motion.state) {
+        return false;
+    }
+
+    run.timestamp = motion.timestamp;
+    run.x         = motion.x;
+    run.y         = motion.y;
+    run.xrel     += motion.xrel;
+    run.yrel     += motion.yrel;
+    merged_++;
+    return true;
+}
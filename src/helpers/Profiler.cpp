@@ -0,0 +1,152 @@
+#include <SDL2/SDL.h>
+
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "helpers/Profiler.hpp"
+#include "helpers/FramePacer.hpp"
+
+using std::cout;
+
+namespace {
+    struct ZoneEvent {
+        char const* name;
+        Uint64 begin;
+        Uint64 end;
+    };
+
+    /** Fixed block of events. Only the owning thread writes, count publishes each new event to readers. */
+    struct Block {
+        static const auto CAPACITY = std::size_t{4096};
+
+        std::array<ZoneEvent, CAPACITY> events;
+        std::atomic<std::size_t> count{0};
+        std::atomic<Block*> next{nullptr};
+    };
+
+    struct ThreadBuffer {
+        int thread_id;
+        Block head;
+        Block* tail;
+
+        explicit ThreadBuffer(int id): thread_id(id), head(), tail(&head) {}
+
+        ~ThreadBuffer() {
+            auto block = head.next.load();
+            while (block) {
+                auto next = block->next.load();
+                delete block;
+                block = next;
+            }
+        }
+    };
+
+    // The registry lock is only taken when a thread records its first zone, and when exporting
+    std::mutex registry_mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> registry;
+
+    auto threadBuffer() -> ThreadBuffer& {
+        thread_local auto buffer = [] {
+            auto lock = std::lock_guard<std::mutex>{registry_mutex};
+            auto created = std::make_shared<ThreadBuffer>(static_cast<int>(registry.size()) + 1);
+            registry.push_back(created);
+            return created;
+        }();
+        return *buffer;
+    }
+
+    /** Trace timestamps are in microseconds, the nanoseconds are kept as the fraction */
+    auto writeMicroseconds(std::ostream& out, Uint64 ns) -> void {
+        out << ns / 1000 << "." << std::setfill('0') << std::setw(3) << ns % 1000;
+    }
+
+    auto writeEscaped(std::ostream& out, char const* text) -> void {
+        for (; *text; text++) {
+            if (*text == '"' || *text == '\\') {
+                out << '\\';
+            }
+            out << *text;
+        }
+    }
+}
+
+
+auto profiler::record(char const* name, Uint64 begin, Uint64 end) -> void {
+    auto& buffer = threadBuffer();
+    auto  tail   = buffer.tail;
+    auto  count  = tail->count.load(std::memory_order_relaxed);
+
+    if (count == Block::CAPACITY) {
+        // Blocks left over from before a clear() are reused before allocating new ones
+        auto block = tail->next.load(std::memory_order_relaxed);
+        if (!block) {
+            block = new Block{};
+            tail->next.store(block, std::memory_order_release);
+        }
+        buffer.tail = block;
+        tail  = block;
+        count = 0;
+    }
+
+    tail->events[count] = {name, begin, end};
+    tail->count.store(count + 1, std::memory_order_release);
+}
+
+
+auto profiler::exportChromeTrace(char const* file_name) -> bool {
+    auto file = std::ofstream{file_name};
+    if (!file) {
+        cout << "Unable to open " << file_name << " for trace output.\n";
+        return false;
+    }
+
+    auto lock  = std::lock_guard<std::mutex>{registry_mutex};
+    auto first = true;
+
+    file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    for (auto const& buffer : registry) {
+        for (auto block = &buffer->head; block; block = block->next.load(std::memory_order_acquire)) {
+            auto count = block->count.load(std::memory_order_acquire);
+            for (auto i = std::size_t{0}; i < count; i++) {
+                auto const& event = block->events[i];
+
+                file << (first ? "\n" : ",\n") << "{\"name\":\"";
+                writeEscaped(file, event.name);
+                file << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->thread_id << ",\"ts\":";
+                writeMicroseconds(file, event.begin);
+                file << ",\"dur\":";
+                writeMicroseconds(file, event.end - event.begin);
+                file << "}";
+                first = false;
+            }
+        }
+    }
+    file << "\n]}\n";
+
+    return static_cast<bool>(file);
+}
+
+
+/** Only safe while no other thread is recording */
+auto profiler::clear() -> void {
+    auto lock = std::lock_guard<std::mutex>{registry_mutex};
+    for (auto const& buffer : registry) {
+        for (auto block = &buffer->head; block; block = block->next.load()) {
+            block->count.store(0);
+        }
+        buffer->tail = &buffer->head;
+    }
+}
+
+
+profiler::Zone::Zone(char const* name): name_(name), begin_(FramePacer::now()) {}
+
+profiler::Zone::~Zone() {
+    profiler::record(name_, begin_, FramePacer::now());
+}
@@ -0,0 +1,157 @@
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "helpers/StagingPool.hpp"
+#include "helpers/inventory.hpp"
+#include "helpers/residency.hpp"
+#include "helpers/Profiler.hpp"
+
+using std::cout;
+
+
+auto StagingPool::KeyHash::operator()(Key const& key) const -> std::size_t {
+    auto hash = std::hash<Uint64>{};
+    return hash((static_cast<Uint64>(key.format) << 32) ^ (static_cast<Uint64>(key.w) << 16) ^ static_cast<Uint64>(key.h));
+}
+
+StagingPool::State::~State() {
+    for (auto& [key, free] : surfaces) {
+        for (auto surface : free) {
+            SDL_FreeSurface(surface);
+        }
+    }
+    for (auto& [key, free] : textures) {
+        for (auto texture : free) {
+            residency::destroyTexture(texture);
+        }
+    }
+}
+
+
+StagingPool::StagingPool(): StagingPool(SDL_PIXELFORMAT_ARGB8888) {}
+StagingPool::StagingPool(Uint32 format): state_(std::make_shared<State>()), format_(format) {}
+
+/** Smallest power of two that fits, at least 16 so tiny sizes share a bucket */
+auto StagingPool::sizeClass(int size) -> int {
+    auto result = 16;
+    while (result < size) {
+        result *= 2;
+    }
+    return result;
+}
+
+auto StagingPool::acquireSurface(Key const& key) -> SDL_Surface* {
+    auto& free = state_->surfaces[key];
+    if (!free.empty()) {
+        auto surface = free.back();
+        free.pop_back();
+        return surface;
+    }
+
+    state_->stats.surfaces_created++;
+    return SDL_CreateRGBSurfaceWithFormat(0, key.w, key.h, SDL_BITSPERPIXEL(key.format), key.format);
+}
+
+auto StagingPool::acquireTexture(SDL_Renderer* renderer, Key const& key) -> SDL_Texture* {
+    auto& free = state_->textures[key];
+    if (!free.empty()) {
+        auto texture = free.back();
+        free.pop_back();
+        state_->stats.textures_reused++;
+        return texture;
+    }
+
+    auto texture = SDL_CreateTexture(renderer, key.format, SDL_TEXTUREACCESS_STREAMING, key.w, key.h);
+    if (!texture) {
+        return nullptr;
+    }
+    state_->stats.textures_created++;
+    return inventory::track(residency::track(texture), "staging pool");
+}
+
+
+auto StagingPool::upload(ManagedSDLRenderer& renderer, SDL_Surface* source) -> ManagedSDLTexture {
+    PROFILE_FUNCTION();
+
+    if (!source) {
+        return {};
+    }
+
+    auto key     = Key{format_, sizeClass(source->w), sizeClass(source->h)};
+    auto texture = acquireTexture(renderer, key);
+    if (!texture) {
+        cout << "Unable to create staging texture. SDL Error: " << SDL_GetError() << "\n";
+        return {};
+    }
+
+    // Whoever had the texture last may have tinted it
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureColorMod(texture, 0xff, 0xff, 0xff);
+    SDL_SetTextureAlphaMod(texture, 0xff);
+
+    auto region = SDL_Rect{0, 0, source->w, source->h};
+    if (source->format->format == format_ && !SDL_HasColorKey(source)) {
+        SDL_UpdateTexture(texture, &region, source->pixels, source->pitch);
+    } else {
+        // Keyed pixels are skipped by the blit, so clearing first turns them transparent
+        auto staging = acquireSurface(key);
+        if (!staging) {
+            cout << "Unable to create staging surface. SDL Error: " << SDL_GetError() << "\n";
+            state_->textures[key].push_back(texture);
+            return {};
+        }
+        SDL_FillRect(staging, &region, 0);
+        SDL_SetSurfaceBlendMode(source, SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(source, nullptr, staging, &region);
+        SDL_UpdateTexture(texture, &region, staging->pixels, staging->pitch);
+        state_->surfaces[key].push_back(staging);
+    }
+    state_->stats.uploads++;
+
+    // The last copy hands the texture back instead of destroying it
+    auto result = ManagedSDLTexture{};
+    result.resource_ = std::shared_ptr<SDL_Texture>{texture, [state=std::weak_ptr<State>{state_}, key](SDL_Texture* released) {
+        if (auto pool = state.lock()) {
+            pool->textures[key].push_back(released);
+        } else {
+            residency::destroyTexture(released);
+        }
+    }};
+    result.src_clip_ = region;
+    return result;
+}
+
+auto StagingPool::text(ManagedSDLRenderer& renderer, char const* string_to_render, ManagedTTFFont& font, SDL_Colour const& colour) -> ManagedSDLTexture {
+    PROFILE_FUNCTION();
+
+    auto surface = ManagedSDLSurface{TTF_RenderText_Solid(font, string_to_render, colour)};
+    if (!surface) {
+        cout << "Unable to render text to surface. SDL_ttf Error: " << TTF_GetError() << "\n";
+        return {};
+    }
+    return upload(renderer, surface);
+}
+
+auto StagingPool::image(ManagedSDLRenderer& renderer, char const* image_name, std::optional<SDL_Colour> color_key) -> ManagedSDLTexture {
+    PROFILE_FUNCTION();
+
+    auto surface = ManagedSDLSurface{IMG_Load(image_name)};
+    if (!surface) {
+        cout << "Unable to load image " << image_name << ". SDL_image Error: " << IMG_GetError() << "\n";
+        return {};
+    }
+
+    if (color_key) {
+        SDL_SetColorKey(surface, SDL_TRUE, SDL_MapRGB(surface->format, color_key->r, color_key->g, color_key->b));
+    }
+    return upload(renderer, surface);
+}
+
+auto StagingPool::stats() const -> Stats { return state_->stats; }
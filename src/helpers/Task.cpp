@@ -0,0 +1,142 @@
+#include <SDL2/SDL.h>
+
+#include <coroutine>
+
+#include "helpers/Task.hpp"
+
+
+Waiter::Waiter(): handle_(), prev_(nullptr), next_(nullptr), list_(nullptr) {}
+
+Waiter::~Waiter() {
+    if (list_) {
+        list_->remove(*this);
+    }
+}
+
+
+WaitList::WaitList(): head_(nullptr) {}
+
+WaitList::~WaitList() {
+    destroyAll();
+}
+
+auto WaitList::empty() const -> bool { return head_ == nullptr; }
+
+auto WaitList::push(Waiter& waiter, std::coroutine_handle<> handle) -> void {
+    waiter.handle_ = handle;
+    waiter.list_   = this;
+    waiter.prev_   = nullptr;
+    waiter.next_   = head_;
+    if (head_) {
+        head_->prev_ = &waiter;
+    }
+    head_ = &waiter;
+}
+
+auto WaitList::remove(Waiter& waiter) -> void {
+    if (waiter.prev_) {
+        waiter.prev_->next_ = waiter.next_;
+    } else {
+        head_ = waiter.next_;
+    }
+    if (waiter.next_) {
+        waiter.next_->prev_ = waiter.prev_;
+    }
+    waiter.prev_ = nullptr;
+    waiter.next_ = nullptr;
+    waiter.list_ = nullptr;
+}
+
+/** Coroutines that wait on this list again while resuming are left for the next call */
+auto WaitList::resumeAll() -> void {
+    auto batch = WaitList{};
+    while (head_) {
+        auto& waiter = *head_;
+        remove(waiter);
+        batch.push(waiter, waiter.handle_);
+    }
+
+    while (batch.head_) {
+        auto handle = batch.head_->handle_;
+        batch.remove(*batch.head_);
+        handle.resume();
+    }
+}
+
+auto WaitList::destroyAll() -> void {
+    // Destroying the frame runs the waiter's destructor, which unlinks it
+    while (head_) {
+        head_->handle_.destroy();
+    }
+}
+
+
+Completion::Completion(): done_(false), waiters_() {}
+
+auto Completion::done() const -> bool { return done_; }
+
+auto Completion::complete() -> void {
+    done_ = true;
+    waiters_.resumeAll();
+}
+
+auto Completion::reset() -> void { done_ = false; }
+
+auto Completion::operator co_await() -> Awaiter { return Awaiter{*this}; }
+
+
+auto Scheduler::DelayAwaiter::await_suspend(std::coroutine_handle<> handle) -> void {
+    scheduler.sleeping_.push(*this, handle);
+    scheduler.timers_.after(delay, [this] {
+        auto resumed = handle_;
+        scheduler.sleeping_.remove(*this);
+        resumed.resume();
+    });
+}
+
+
+Scheduler::Scheduler(): Scheduler(Clock::real()) {}
+
+Scheduler::Scheduler(Clock& clock): timers_(clock), next_frame_(), sleeping_(), events_() {}
+
+Scheduler::Scheduler(Uint32 start_ticks): timers_(start_ticks), next_frame_(), sleeping_(), events_() {}
+
+Scheduler::~Scheduler() {
+    // Frames are destroyed before the timer wheel so no callback can reach a dead awaiter
+    next_frame_.destroyAll();
+    sleeping_.destroyAll();
+    for (auto& [type, waiters] : events_) {
+        waiters.destroyAll();
+    }
+}
+
+auto Scheduler::timers() -> TimerWheel& { return timers_; }
+
+auto Scheduler::nextFrame()               -> FrameAwaiter        { return FrameAwaiter{*this}; }
+auto Scheduler::delay(Uint32 ms)          -> DelayAwaiter        { return DelayAwaiter{*this, ms}; }
+auto Scheduler::event(Uint32 event_type)  -> EventAwaiter        { return EventAwaiter{*this, event_type}; }
+auto Scheduler::loaded(Completion& asset) -> Completion::Awaiter { return Completion::Awaiter{asset}; }
+
+
+auto Scheduler::dispatch(SDL_Event const& event) -> void {
+    auto waiters = events_.find(event.type);
+    if (waiters == events_.end() || waiters->second.empty()) {
+        return;
+    }
+
+    // Every waiter on an event list is an EventAwaiter, hand them the event before resuming
+    for (auto waiter = waiters->second.head_; waiter; waiter = waiter->next_) {
+        static_cast<EventAwaiter*>(waiter)->event = event;
+    }
+    waiters->second.resumeAll();
+}
+
+auto Scheduler::frame(Uint32 ticks) -> void {
+    timers_.advance(ticks);
+    next_frame_.resumeAll();
+}
+
+auto Scheduler::frame() -> void {
+    timers_.update();
+    next_frame_.resumeAll();
+}
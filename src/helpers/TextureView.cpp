@@ -0,0 +1,56 @@
+#include <SDL2/SDL.h>
+
+#include <optional>
+
+#include "helpers/TextureView.hpp"
+#include "helpers/Profiler.hpp"
+
+
+TextureView::TextureView(): texture_(nullptr), src_clip_{0, 0, 0, 0}, base_dim_{0, 0} {}
+
+TextureView::TextureView(SDL_Texture* sdl_texture, std::optional<SDL_Rect> source_clip): texture_(sdl_texture),
+                                                                                           src_clip_{0, 0, 0, 0},
+                                                                                           base_dim_{0, 0} {
+    if (sdl_texture) {
+        SDL_QueryTexture(sdl_texture, nullptr, nullptr, &base_dim_.x, &base_dim_.y);
+    }
+    src_clip_ = source_clip ? *source_clip : SDL_Rect{0, 0, base_dim_.x, base_dim_.y};
+}
+
+
+auto TextureView::baseDim() const -> SDL_Point { return base_dim_; }
+
+auto TextureView::rect() const -> SDL_Rect const& { return src_clip_; }
+auto TextureView::pos() const -> SDL_Point { return {src_clip_.x, src_clip_.y}; }
+auto TextureView::dim() const -> SDL_Point { return {src_clip_.w, src_clip_.h}; }
+
+auto TextureView::sub(SDL_Rect const& clip) const -> TextureView {
+    auto view = *this;
+    view.src_clip_ = {src_clip_.x + clip.x, src_clip_.y + clip.y, clip.w, clip.h};
+    return view;
+}
+
+auto TextureView::setClip(SDL_Rect const& rect) -> TextureView& { src_clip_ = rect; return *this; }
+auto TextureView::setClipPos(SDL_Point const& pos) -> TextureView& { src_clip_.x = pos.x; src_clip_.y = pos.y; return *this; }
+auto TextureView::setClipDim(SDL_Point const& dim) -> TextureView& { src_clip_.w = dim.x; src_clip_.h = dim.y; return *this; }
+
+auto TextureView::render(SDL_Renderer* renderer,
+                         SDL_Rect* clip,
+                         double angle,
+                         SDL_Point* center,
+                         SDL_RendererFlip flip) const -> void {
+    PROFILE_ZONE("TextureView::render");
+    SDL_RenderCopyEx(renderer, texture_, &src_clip_, clip, angle, center, flip);
+}
+auto TextureView::render(SDL_Renderer* renderer, SDL_Rect* clip, SDL_RendererFlip flip) const -> void {
+    render(renderer, clip, 0.0, nullptr, flip);
+}
+auto TextureView::render(SDL_Renderer* renderer, SDL_Rect* clip, double angle, SDL_Point* center) const -> void {
+    render(renderer, clip, angle, center, SDL_FLIP_NONE);
+}
+auto TextureView::render(SDL_Renderer* renderer, SDL_Rect* clip) const -> void {
+    render(renderer, clip, 0.0, nullptr, SDL_FLIP_NONE);
+}
+auto TextureView::render(SDL_Renderer* renderer) const -> void {
+    render(renderer, nullptr, 0.0, nullptr, SDL_FLIP_NONE);
+}
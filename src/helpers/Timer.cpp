@@ -5,7 +5,7 @@
 
 auto Timer::update() -> void {
     if (!paused_) {
-        time_ = std::min(SDL_GetTicks(), stop_time_);
+        time_ = std::min(clock_->ticks(), stop_time_);
     }
 }
 
@@ -28,18 +28,23 @@ auto Timer::elapsed()  -> Uint32 {
     return time_ - begin_time_;
 }
 
-Timer::Timer() {
-    time_ = SDL_GetTicks();
+Timer::Timer(): Timer(Clock::real()) {}
+Timer::Timer(Uint32 duration): Timer(duration, Clock::real()) {}
+
+Timer::Timer(Clock& clock): clock_(&clock), paused_(false) {
+    time_ = clock_->ticks();
     begin_time_ = time_;
     stop_time_ = std::numeric_limits<decltype(stop_time_)>::max();
 }
-Timer::Timer(Uint32 duration) {
-    time_ = SDL_GetTicks();
+Timer::Timer(Uint32 duration, Clock& clock): clock_(&clock), paused_(false) {
+    time_ = clock_->ticks();
     begin_time_ = time_;
     duration_ = duration;
     stop_time_ = time_ + *duration_;
 }
 
+auto Timer::clock() -> Clock& { return *clock_; }
+
 auto Timer::pause() -> void {
     if (!paused_) {
         update();
@@ -48,7 +53,7 @@ auto Timer::pause() -> void {
 }
 auto Timer::unpause() -> void {
     if (paused_) {
-        auto time = SDL_GetTicks();
+        auto time = clock_->ticks();
         auto diff = time - time_;
         time_ = time;
 
@@ -63,7 +68,7 @@ auto Timer::unpause() -> void {
 
 auto Timer::reset(bool pause)    -> void {
     paused_ = pause;
-    time_ = SDL_GetTicks();
+    time_ = clock_->ticks();
     begin_time_ = time_;
     if (duration_) {
         stop_time_ = time_ + *duration_;
@@ -0,0 +1,257 @@
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "helpers/TimerWheel.hpp"
+
+
+TimerWheel::TimerWheel(): TimerWheel(Clock::real()) {}
+
+TimerWheel::TimerWheel(Clock& clock): TimerWheel(clock.ticks()) {
+    clock_ = &clock;
+}
+
+TimerWheel::TimerWheel(Uint32 start_ticks):     nodes_(),
+                                                free_(),
+                                                heads_(),
+                                                clock_(&Clock::real()),
+                                                now_(start_ticks),
+                                                firing_(NONE),
+                                                size_(0) {
+    heads_.fill(NONE);
+}
+
+auto TimerWheel::now()  const -> Uint32 { return now_; }
+auto TimerWheel::size() const -> std::size_t { return size_; }
+
+
+auto TimerWheel::node(TimerHandle handle) -> Node* {
+    if (handle.index >= nodes_.size()) { return nullptr; }
+    auto& n = nodes_[handle.index];
+    return (n.active && n.generation == handle.generation) ? &n : nullptr;
+}
+
+auto TimerWheel::node(TimerHandle handle) const -> Node const* {
+    if (handle.index >= nodes_.size()) { return nullptr; }
+    auto const& n = nodes_[handle.index];
+    return (n.active && n.generation == handle.generation) ? &n : nullptr;
+}
+
+
+auto TimerWheel::schedule(Callback&& callback, Uint32 delay, Uint32 period) -> TimerHandle {
+    auto index = Uint32{0};
+    if (free_.empty()) {
+        index = static_cast<Uint32>(nodes_.size());
+        nodes_.push_back(Node{{}, 0, 0, 0, 0, NONE, NONE, NONE, false, false});
+    } else {
+        index = free_.back();
+        free_.pop_back();
+    }
+
+    auto& n     = nodes_[index];
+    n.callback  = std::move(callback);
+    n.expires   = now_ + std::max(delay, Uint32{1});
+    n.period    = period;
+    n.remaining = 0;
+    n.active    = true;
+    n.paused    = false;
+
+    insert(index);
+    size_++;
+
+    return {index, n.generation};
+}
+
+/** Picks the finest level whose range covers the delay. Delays past the top level are parked there and re-cascaded. */
+auto TimerWheel::insert(Uint32 index) -> void {
+    auto delta = std::min(nodes_[index].expires - now_, MAX_DELAY);
+    auto when  = now_ + delta;
+
+    if (delta < LEVEL0_SLOTS) {
+        link(index, when & (LEVEL0_SLOTS-1));
+        return;
+    }
+
+    for (auto level = 1; level < LEVELS; level++) {
+        auto shift = LEVEL0_BITS + (level-1) * LEVELN_BITS;
+        if (level == LEVELS-1 || delta < (1u << (shift + LEVELN_BITS))) {
+            link(index, LEVEL0_SLOTS + (level-1) * LEVELN_SLOTS + ((when >> shift) & (LEVELN_SLOTS-1)));
+            return;
+        }
+    }
+}
+
+auto TimerWheel::link(Uint32 index, Uint32 slot) -> void {
+    auto& n = nodes_[index];
+    n.slot = slot;
+    n.prev = NONE;
+    n.next = heads_[slot];
+    if (n.next != NONE) {
+        nodes_[n.next].prev = index;
+    }
+    heads_[slot] = index;
+}
+
+auto TimerWheel::unlink(Uint32 index) -> void {
+    auto& n = nodes_[index];
+    if (n.slot == NONE) { return; }
+
+    if (n.prev != NONE) {
+        nodes_[n.prev].next = n.next;
+    } else {
+        heads_[n.slot] = n.next;
+    }
+    if (n.next != NONE) {
+        nodes_[n.next].prev = n.prev;
+    }
+
+    n.prev = NONE;
+    n.next = NONE;
+    n.slot = NONE;
+}
+
+auto TimerWheel::release(Uint32 index) -> void {
+    auto& n = nodes_[index];
+    n.callback = nullptr;
+    n.active   = false;
+    n.paused   = false;
+    n.generation++;
+    free_.push_back(index);
+    size_--;
+}
+
+
+/** Redistributes the current slot of a level into the levels below it, returns that slot's index */
+auto TimerWheel::cascade(int level) -> Uint32 {
+    auto shift = LEVEL0_BITS + (level-1) * LEVELN_BITS;
+    auto index = (now_ >> shift) & (LEVELN_SLOTS-1);
+    auto slot  = LEVEL0_SLOTS + static_cast<Uint32>(level-1) * LEVELN_SLOTS + index;
+
+    auto current = heads_[slot];
+    heads_[slot] = NONE;
+    while (current != NONE) {
+        auto next = nodes_[current].next;
+        insert(current);
+        current = next;
+    }
+
+    return index;
+}
+
+auto TimerWheel::tick() -> void {
+    now_++;
+
+    auto index = now_ & (LEVEL0_SLOTS-1);
+    if (index == 0) {
+        for (auto level = 1; level < LEVELS && cascade(level) == 0; level++) {}
+    }
+
+    // Expiring timers move to a pending list so callbacks can cancel or schedule timers safely
+    heads_[PENDING_SLOT] = heads_[index];
+    heads_[index] = NONE;
+    for (auto i = heads_[PENDING_SLOT]; i != NONE; i = nodes_[i].next) {
+        nodes_[i].slot = PENDING_SLOT;
+    }
+
+    while (heads_[PENDING_SLOT] != NONE) {
+        firing_ = heads_[PENDING_SLOT];
+        unlink(firing_);
+
+        nodes_[firing_].callback();
+
+        auto& n = nodes_[firing_];
+        if (!n.active || (!n.period && !n.paused)) {
+            release(firing_);
+        } else if (!n.paused) {
+            n.expires = now_ + n.period;
+            insert(firing_);
+        }
+    }
+    firing_ = NONE;
+}
+
+
+auto TimerWheel::after(Uint32 delay, Callback callback) -> TimerHandle {
+    return schedule(std::move(callback), delay, 0);
+}
+
+auto TimerWheel::every(Uint32 period, Callback callback) -> TimerHandle {
+    return every(period, period, std::move(callback));
+}
+
+auto TimerWheel::every(Uint32 period, Uint32 first_delay, Callback callback) -> TimerHandle {
+    return schedule(std::move(callback), first_delay, std::max(period, Uint32{1}));
+}
+
+
+auto TimerWheel::active(TimerHandle handle) const -> bool { return node(handle) != nullptr; }
+
+auto TimerWheel::paused(TimerHandle handle) const -> bool {
+    auto n = node(handle);
+    return n && n->paused;
+}
+
+auto TimerWheel::remaining(TimerHandle handle) const -> Uint32 {
+    auto n = node(handle);
+    if (!n)        { return 0; }
+    if (n->paused) { return n->remaining; }
+    return handle.index == firing_ ? 0 : n->expires - now_;
+}
+
+
+auto TimerWheel::cancel(TimerHandle handle) -> bool {
+    auto n = node(handle);
+    if (!n) { return false; }
+
+    // A timer cancelling itself is released once its callback returns
+    if (handle.index == firing_) {
+        n->active = false;
+    } else {
+        unlink(handle.index);
+        release(handle.index);
+    }
+    return true;
+}
+
+auto TimerWheel::pause(TimerHandle handle) -> bool {
+    auto n = node(handle);
+    if (!n || n->paused) { return false; }
+
+    if (handle.index == firing_) {
+        n->remaining = n->period;
+    } else {
+        n->remaining = n->expires - now_;
+        unlink(handle.index);
+    }
+    n->paused = true;
+    return true;
+}
+
+auto TimerWheel::resume(TimerHandle handle) -> bool {
+    auto n = node(handle);
+    if (!n || !n->paused) { return false; }
+
+    n->paused  = false;
+    n->expires = now_ + std::max(n->remaining, Uint32{1});
+    if (handle.index != firing_) {
+        insert(handle.index);
+    }
+    return true;
+}
+
+
+auto TimerWheel::advance(Uint32 ticks) -> void {
+    while (static_cast<Sint32>(ticks - now_) > 0) {
+        // Nothing to expire, skip straight to the target instead of walking empty slots
+        if (size_ == 0) {
+            now_ = ticks;
+            return;
+        }
+        tick();
+    }
+}
+
+auto TimerWheel::update() -> void {
+    advance(clock_->ticks());
+}
@@ -0,0 +1,90 @@
+#include <SDL2/SDL.h>
+
+#include "helpers/actions.hpp"
+
+
+ActionMap::ActionMap(): actions_() {}
+
+auto ActionMap::state(Action action) -> State& {
+    if (action >= actions_.size()) {
+        actions_.resize(action + 1, State{{}, false, false, false});
+    }
+    return actions_[action];
+}
+
+
+/** Every key in the chord and every button in the mask must be held. An action may have several bindings. */
+auto ActionMap::bind(Action action, std::initializer_list<SDL_Scancode> chord, Uint32 mouse_buttons) -> ActionMap& {
+    auto binding = Binding{{}, mouse_buttons};
+    for (auto key : chord) {
+        if (key < SDL_NUM_SCANCODES) {
+            binding.keys.set(key);
+        }
+    }
+
+    // An empty binding would always be active
+    if (binding.keys.any() || binding.buttons) {
+        state(action).bindings.push_back(binding);
+    }
+    return *this;
+}
+
+auto ActionMap::bindMouse(Action action, Uint32 mouse_buttons) -> ActionMap& {
+    return bind(action, {}, mouse_buttons);
+}
+
+auto ActionMap::clear(Action action) -> ActionMap& {
+    state(action).bindings.clear();
+    return *this;
+}
+
+
+static auto covers(std::bitset<SDL_NUM_SCANCODES> const& keys, Uint32 buttons,
+                   std::bitset<SDL_NUM_SCANCODES> const& binding_keys, Uint32 binding_buttons) -> bool {
+    return (keys & binding_keys) == binding_keys && (buttons & binding_buttons) == binding_buttons;
+}
+
+static auto touches(std::bitset<SDL_NUM_SCANCODES> const& keys, Uint32 buttons,
+                    std::bitset<SDL_NUM_SCANCODES> const& binding_keys, Uint32 binding_buttons) -> bool {
+    return (keys & binding_keys).any() || (buttons & binding_buttons);
+}
+
+/**
+ * A binding is pressed when one of its inputs went down this frame and every other one was held at some
+ * point in it, and released when one of them came up after the whole binding had been held.
+ */
+auto ActionMap::update(InputSnapshot const& input) -> void {
+    auto reached_keys    = input.keys_down | input.keys_pressed;
+    auto reached_buttons = input.buttons_down | input.buttons_pressed;
+    auto before_keys     = input.keys_down | input.keys_released;
+    auto before_buttons  = input.buttons_down | input.buttons_released;
+
+    for (auto& action : actions_) {
+        action.active   = false;
+        action.pressed  = false;
+        action.released = false;
+
+        for (auto const& binding : action.bindings) {
+            action.active   = action.active || covers(input.keys_down, input.buttons_down, binding.keys, binding.buttons);
+            action.pressed  = action.pressed ||
+                              (touches(input.keys_pressed, input.buttons_pressed, binding.keys, binding.buttons) &&
+                               covers(reached_keys, reached_buttons, binding.keys, binding.buttons));
+            action.released = action.released ||
+                              (touches(input.keys_released, input.buttons_released, binding.keys, binding.buttons) &&
+                               covers(before_keys, before_buttons, binding.keys, binding.buttons));
+        }
+    }
+}
+
+
+auto ActionMap::held(Action action) const -> bool {
+    return action < actions_.size() && actions_[action].active;
+}
+
+auto ActionMap::pressed(Action action) const -> bool {
+    return action < actions_.size() && actions_[action].pressed;
+}
+
+auto ActionMap::released(Action action) const -> bool {
+    return action < actions_.size() && actions_[action].released;
+}
@@ -0,0 +1,218 @@
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "helpers/allocations.hpp"
+
+using std::cout;
+
+
+namespace {
+    /** Sits in front of every block, padded so the block keeps malloc's alignment */
+    struct Header {
+        std::size_t size;
+        Uint32      magic;
+        Uint8       phase;
+    };
+
+    constexpr auto HEADER_SIZE = alignof(std::max_align_t) >= sizeof(Header) ? alignof(std::max_align_t)
+                                                                              : 2 * alignof(std::max_align_t);
+    constexpr auto MAGIC       = Uint32{0x5D1A110C};
+
+    struct Counters {
+        std::atomic<Uint64> live_bytes;
+        std::atomic<Uint64> live_count;
+        std::atomic<Uint64> total_count;
+    };
+}
+
+// SDL may allocate from its own threads, and these have to outlive every static destructor
+static SDL_malloc_func  original_malloc  = nullptr;
+static SDL_calloc_func  original_calloc  = nullptr;
+static SDL_realloc_func original_realloc = nullptr;
+static SDL_free_func    original_free    = nullptr;
+
+static Counters                phases[2];
+static std::atomic<Uint64>     live_bytes{0};
+static std::atomic<Uint64>     peak_bytes{0};
+static std::atomic<Uint64>     frame_count{0};
+static std::atomic<Uint64>     frame_bytes{0};
+static std::atomic<Uint64>     last_frame_count{0};
+static std::atomic<Uint64>     last_frame_bytes{0};
+static std::atomic<Uint8>      current_phase{static_cast<Uint8>(allocations::Phase::load)};
+static std::atomic<bool>       is_installed{false};
+
+// Only touched by expectSteady() on the frame loop's thread, steady_live is the high water mark
+static Uint64                  steady_frames = 0;
+static Uint64                  steady_live   = 0;
+
+
+static auto added(Header* header, std::size_t size) -> void* {
+    auto phase = current_phase.load(std::memory_order_relaxed);
+    *header = Header{size, MAGIC, phase};
+
+    phases[phase].live_bytes.fetch_add(size, std::memory_order_relaxed);
+    phases[phase].live_count.fetch_add(1, std::memory_order_relaxed);
+    phases[phase].total_count.fetch_add(1, std::memory_order_relaxed);
+    frame_count.fetch_add(1, std::memory_order_relaxed);
+    frame_bytes.fetch_add(size, std::memory_order_relaxed);
+
+    auto live = live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+    auto peak = peak_bytes.load(std::memory_order_relaxed);
+    while (live > peak && !peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+
+    return reinterpret_cast<std::byte*>(header) + HEADER_SIZE;
+}
+
+static auto removed(Header const& header) -> void {
+    phases[header.phase].live_bytes.fetch_sub(header.size, std::memory_order_relaxed);
+    phases[header.phase].live_count.fetch_sub(1, std::memory_order_relaxed);
+    live_bytes.fetch_sub(header.size, std::memory_order_relaxed);
+}
+
+static auto headerOf(void* memory) -> Header* {
+    auto header = reinterpret_cast<Header*>(static_cast<std::byte*>(memory) - HEADER_SIZE);
+    if (header->magic != MAGIC) {
+        cout << "SDL freed a block the allocation tracker didn't make.\n";
+        std::abort();
+    }
+    return header;
+}
+
+
+static auto trackedMalloc(std::size_t size) -> void* {
+    auto header = static_cast<Header*>(original_malloc(HEADER_SIZE + size));
+    return header ? added(header, size) : nullptr;
+}
+
+static auto trackedCalloc(std::size_t count, std::size_t size) -> void* {
+    if (size != 0 && count > (SIZE_MAX - HEADER_SIZE) / size) {
+        return nullptr;
+    }
+    auto memory = trackedMalloc(count * size);
+    if (memory) {
+        std::memset(memory, 0, count * size);
+    }
+    return memory;
+}
+
+/** Counts as a new allocation in the current phase; on failure the old block is untouched and stays counted */
+static auto trackedRealloc(void* memory, std::size_t size) -> void* {
+    if (!memory) {
+        return trackedMalloc(size);
+    }
+
+    auto header = headerOf(memory);
+    auto old    = *header;
+    auto moved  = static_cast<Header*>(original_realloc(header, HEADER_SIZE + size));
+    if (!moved) {
+        return nullptr;
+    }
+
+    removed(old);
+    return added(moved, size);
+}
+
+static auto trackedFree(void* memory) -> void {
+    if (!memory) {
+        return;
+    }
+    auto header = headerOf(memory);
+    removed(*header);
+    header->magic = 0;
+    original_free(header);
+}
+
+
+auto allocations::install() -> bool {
+    if (is_installed) {
+        return true;
+    }
+
+    // Blocks SDL already handed out have no header, freeing one through the hooks would read garbage
+    if (SDL_GetNumAllocations() > 0) {
+        cout << "SDL has already allocated, not tracking its memory.\n";
+        return false;
+    }
+
+    SDL_GetMemoryFunctions(&original_malloc, &original_calloc, &original_realloc, &original_free);
+    if (SDL_SetMemoryFunctions(trackedMalloc, trackedCalloc, trackedRealloc, trackedFree) != 0) {
+        cout << "Could not install SDL memory functions. SDL_Error: " << SDL_GetError() << "\n";
+        return false;
+    }
+
+    is_installed = true;
+    std::atexit(report);
+    return true;
+}
+
+auto allocations::installed() -> bool { return is_installed; }
+
+auto allocations::setPhase(Phase phase) -> void { current_phase = static_cast<Uint8>(phase); }
+
+auto allocations::beginFrame() -> void {
+    setPhase(Phase::frame);
+    last_frame_count = frame_count.exchange(0, std::memory_order_relaxed);
+    last_frame_bytes = frame_bytes.exchange(0, std::memory_order_relaxed);
+}
+
+auto allocations::expectSteady(Uint64 upstream, Uint64 warmup) -> void {
+    auto live = phases[static_cast<Uint8>(Phase::frame)].live_count.load(std::memory_order_relaxed);
+    steady_frames++;
+
+#ifdef DEBUG
+    if (steady_frames > warmup && upstream > 0) {
+        cout << "Frame " << steady_frames << " allocated after the loop settled: " << upstream
+             << " upstream arena blocks" << std::endl;
+        std::abort();
+    }
+
+    // SDL keeps some blocks on free lists of its own (event queue entries, for one) and grows them to fit
+    // the biggest input burst so far, so growth is only reported, and only when it's a new high
+    if (steady_frames > warmup && live > steady_live) {
+        cout << "Frame " << steady_frames << " left " << live - steady_live << " more SDL blocks alive than"
+             << " any frame before it\n";
+    }
+#else
+    static_cast<void>(upstream);
+    static_cast<void>(warmup);
+#endif
+    steady_live = std::max(steady_live, live);
+}
+
+static auto phaseStats(Counters const& counters) -> allocations::PhaseStats {
+    return {counters.live_bytes.load(std::memory_order_relaxed),
+            counters.live_count.load(std::memory_order_relaxed),
+            counters.total_count.load(std::memory_order_relaxed)};
+}
+
+auto allocations::stats() -> Stats {
+    return {phaseStats(phases[static_cast<Uint8>(Phase::load)]),
+            phaseStats(phases[static_cast<Uint8>(Phase::frame)]),
+            live_bytes.load(std::memory_order_relaxed),
+            peak_bytes.load(std::memory_order_relaxed),
+            last_frame_count.load(std::memory_order_relaxed),
+            last_frame_bytes.load(std::memory_order_relaxed)};
+}
+
+auto allocations::report() -> void {
+    if (!is_installed) {
+        return;
+    }
+
+    auto s = stats();
+    cout << "SDL heap: peak " << s.peak_bytes << " bytes, "
+         << s.load.total_count << " allocations while loading, "
+         << s.frame.total_count << " during frames\n";
+    if (s.live_bytes > 0) {
+        cout << "SDL heap still allocated: "
+             << s.load.live_bytes << " bytes in " << s.load.live_count << " blocks from loading, "
+             << s.frame.live_bytes << " bytes in " << s.frame.live_count << " blocks from frames\n";
+    }
+}
@@ -7,12 +7,15 @@
 #include <utility>
 #include <optional>
 #include <iostream>
+#include <string>
 
 #include <SDL_helpers.hpp>
 
 using std::cout;
 
 auto loadSurface(char const* image_name, ManagedSDLSurface& screen_surface) -> SDL_Surface* {
+    PROFILE_FUNCTION();
+
     SDL_Surface *image_surface = {};
     auto raw_surface = ManagedSDLSurface{IMG_Load(image_name)};
 
@@ -26,11 +29,13 @@ auto loadSurface(char const* image_name, ManagedSDLSurface& screen_surface) -> S
         return {};
     }
 
-    return image_surface;
+    return inventory::track(image_surface, image_name);
 }
 
 
 auto loadTextureFromFile(ManagedSDLRenderer& renderer, char const* image_name, std::optional<SDL_Colour> color_key) -> SDL_Texture* {
+    PROFILE_FUNCTION();
+
     SDL_Texture *texture = {};
     auto loaded_surface = ManagedSDLSurface{IMG_Load(image_name)};
 
@@ -49,11 +54,13 @@ auto loadTextureFromFile(ManagedSDLRenderer& renderer, char const* image_name, s
         return {};
     }
 
-    return texture;
+    return inventory::track(residency::track(texture), image_name);
 }
 
 
 auto loadTextureFromText(ManagedSDLRenderer& renderer, char const* string_to_render, ManagedTTFFont& font, SDL_Colour const& colour) -> SDL_Texture* {
+    PROFILE_FUNCTION();
+
     SDL_Texture *texture = {};
     auto loaded_surface = ManagedSDLSurface{TTF_RenderText_Solid(font, string_to_render, colour)};
 
@@ -68,11 +75,34 @@ auto loadTextureFromText(ManagedSDLRenderer& renderer, char const* string_to_ren
         return {};
     }
 
-    return texture;
+    return inventory::track(residency::track(texture), "text");
+}
+
+
+/** The renderer and path are kept for reloading, so both have to outlive the texture */
+auto loadResidentTexture(ManagedSDLRenderer& renderer, char const* image_name, std::optional<SDL_Colour> color_key) -> residency::ResidentTexture {
+    auto path = std::string{image_name};
+    return residency::ResidentTexture{[&renderer, path, color_key]() {
+        return loadTextureFromFile(renderer, path.c_str(), color_key);
+    }};
+}
+
+
+/** Render targets can't be reloaded, their contents would be lost, so they're only counted */
+auto createTargetTexture(ManagedSDLRenderer& renderer, int w, int h, Uint32 format) -> SDL_Texture* {
+    auto texture = SDL_CreateTexture(renderer, format, SDL_TEXTUREACCESS_TARGET, w, h);
+    if (!texture) {
+        cout << "Unable to create target texture. SDL Error: " << SDL_GetError() << "\n";
+        return {};
+    }
+
+    return inventory::track(residency::track(texture), "render target");
 }
 
 
 auto loadFont(char const* font_name, int size) -> TTF_Font* {
+    PROFILE_FUNCTION();
+
     auto font = TTF_OpenFont(font_name, size);
 
     if (!font) {
@@ -80,11 +110,20 @@ auto loadFont(char const* font_name, int size) -> TTF_Font* {
         return {};
     }
 
-    return font;
+    return inventory::track(font, font_name);
 }
 
 
 auto init() -> bool {
+    // Before anything else touches SDL, blocks allocated without the hooks can't be tracked
+    allocations::install();
+
+    // Start recording or replaying if requested, replays need their hints set before SDL starts
+    if (!replay::initFromEnvironment()) {
+        cout << "Could not start input recording or replay.\n";
+        return false;
+    }
+
     // Initialize SDL
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
         cout << "SDL could not initialize. SDL_Error: " << SDL_GetError() << "\n";
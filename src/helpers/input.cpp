@@ -0,0 +1,76 @@
+#include <SDL2/SDL.h>
+
+#include "helpers/input.hpp"
+
+
+InputBuilder::InputBuilder(): current_() {}
+
+/** Held state carries over, per-frame edges and deltas start again */
+auto InputBuilder::beginFrame() -> void {
+    current_.prevx = current_.x;
+    current_.prevy = current_.y;
+    current_.dx    = 0;
+    current_.dy    = 0;
+
+    current_.buttons_pressed  = 0;
+    current_.buttons_released = 0;
+
+    current_.wheel_x = 0;
+    current_.wheel_y = 0;
+
+    current_.keys_pressed.reset();
+    current_.keys_released.reset();
+}
+
+auto InputBuilder::feed(SDL_Event const& event) -> void {
+    switch (event.type) {
+        case SDL_MOUSEMOTION:
+            current_.x   = event.motion.x;
+            current_.y   = event.motion.y;
+            current_.dx += event.motion.xrel;
+            current_.dy += event.motion.yrel;
+            break;
+
+        case SDL_MOUSEBUTTONDOWN:
+            current_.x = event.button.x;
+            current_.y = event.button.y;
+            current_.buttons_down    |= SDL_BUTTON(event.button.button);
+            current_.buttons_pressed |= SDL_BUTTON(event.button.button);
+            break;
+
+        case SDL_MOUSEBUTTONUP:
+            current_.x = event.button.x;
+            current_.y = event.button.y;
+            current_.buttons_down     &= ~static_cast<Uint32>(SDL_BUTTON(event.button.button));
+            current_.buttons_released |= SDL_BUTTON(event.button.button);
+            break;
+
+        case SDL_MOUSEWHEEL: {
+            auto flip = event.wheel.direction == SDL_MOUSEWHEEL_FLIPPED ? -1 : 1;
+            current_.wheel_x += event.wheel.x * flip;
+            current_.wheel_y += event.wheel.y * flip;
+            break;
+        }
+
+        case SDL_KEYDOWN:
+            if (event.key.keysym.scancode < SDL_NUM_SCANCODES) {
+                current_.keys_down.set(event.key.keysym.scancode);
+                if (!event.key.repeat) {
+                    current_.keys_pressed.set(event.key.keysym.scancode);
+                }
+            }
+            break;
+
+        case SDL_KEYUP:
+            if (event.key.keysym.scancode < SDL_NUM_SCANCODES) {
+                current_.keys_down.reset(event.key.keysym.scancode);
+                current_.keys_released.set(event.key.keysym.scancode);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+auto InputBuilder::snapshot() const -> InputSnapshot const& { return current_; }
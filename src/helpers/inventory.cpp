@@ -0,0 +1,125 @@
+#include "helpers/inventory.hpp"
+
+#ifdef TRACK_RESOURCES
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <SDL2/SDL_mixer.h>
+
+#include <chrono>  // NOLINT [build/c++11]
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "helpers/residency.hpp"
+
+using std::cout;
+
+
+namespace {
+    struct Record {
+        inventory::Kind kind;
+        std::string     origin;
+        Uint64          bytes;
+
+        // Not SDL_GetTicks, which starts over after SDL_Quit and the dump runs at exit
+        std::chrono::steady_clock::time_point created;
+    };
+
+    constexpr char const* KIND_NAMES[inventory::KIND_COUNT] = {
+        "window", "renderer", "surface", "texture", "font", "chunk", "music"
+    };
+
+    struct Inventory {
+        std::mutex                                    mutex;
+        std::unordered_map<void const*, Record>       records;
+        inventory::Totals                             totals[inventory::KIND_COUNT];
+    };
+
+    /** The dump is registered once the inventory is fully built, so it runs before the inventory is destroyed */
+    auto instance() -> Inventory& {
+        static auto inventory  = Inventory{};
+        static auto registered = std::atexit(inventory::dump) == 0;
+        static_cast<void>(registered);
+        return inventory;
+    }
+}
+
+static auto record(void const* resource, inventory::Kind kind, Uint64 bytes, std::string_view origin) -> void {
+    auto& inventory = instance();
+    auto lock  = std::scoped_lock{inventory.mutex};
+    auto found = inventory.records.find(resource);
+    if (found != inventory.records.end()) {
+        if (!origin.empty()) {
+            found->second.origin = origin;
+        }
+        return;
+    }
+
+    inventory.records.emplace(resource, Record{kind, std::string{origin}, bytes, std::chrono::steady_clock::now()});
+    auto& totals = inventory.totals[static_cast<std::size_t>(kind)];
+    totals.count++;
+    totals.bytes += bytes;
+}
+
+
+auto inventory::add(SDL_Window* resource, std::string_view origin) -> void { record(resource, Kind::window, 0, origin); }
+auto inventory::add(SDL_Renderer* resource, std::string_view origin) -> void { record(resource, Kind::renderer, 0, origin); }
+auto inventory::add(TTF_Font* resource, std::string_view origin) -> void { record(resource, Kind::font, 0, origin); }
+auto inventory::add(Mix_Music* resource, std::string_view origin) -> void { record(resource, Kind::music, 0, origin); }
+
+auto inventory::add(SDL_Surface* resource, std::string_view origin) -> void {
+    record(resource, Kind::surface, static_cast<Uint64>(resource->pitch) * static_cast<Uint64>(resource->h), origin);
+}
+auto inventory::add(SDL_Texture* resource, std::string_view origin) -> void {
+    record(resource, Kind::texture, residency::textureBytes(resource), origin);
+}
+auto inventory::add(Mix_Chunk* resource, std::string_view origin) -> void {
+    record(resource, Kind::chunk, resource->alen, origin);
+}
+
+auto inventory::remove(void const* resource) -> void {
+    if (!resource) {
+        return;
+    }
+
+    auto& inventory = instance();
+    auto lock  = std::scoped_lock{inventory.mutex};
+    auto found = inventory.records.find(resource);
+    if (found == inventory.records.end()) {
+        return;
+    }
+
+    auto& totals = inventory.totals[static_cast<std::size_t>(found->second.kind)];
+    totals.count--;
+    totals.bytes -= found->second.bytes;
+    inventory.records.erase(found);
+}
+
+auto inventory::totals(Kind kind) -> Totals {
+    auto& inventory = instance();
+    auto lock = std::scoped_lock{inventory.mutex};
+    return inventory.totals[static_cast<std::size_t>(kind)];
+}
+
+auto inventory::dump() -> void {
+    auto& inventory = instance();
+    auto lock = std::scoped_lock{inventory.mutex};
+    if (inventory.records.empty()) {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    cout << inventory.records.size() << " SDL resources still alive:\n";
+    for (auto const& [resource, record] : inventory.records) {
+        auto age = std::chrono::duration_cast<std::chrono::milliseconds>(now - record.created);
+        cout << "    " << KIND_NAMES[static_cast<std::size_t>(record.kind)] << " " << resource
+             << " from " << (record.origin.empty() ? "an unknown origin" : record.origin)
+             << ", " << record.bytes << " bytes, " << age.count() << " ms old\n";
+    }
+}
+
+#endif
@@ -6,23 +6,27 @@ static int mouse_x = 0;
 static int mouse_y = 0;
 static int mouse_prevx = 0;
 static int mouse_prevy = 0;
-static bool mouse_pressed = false;
+static Uint32 mouse_buttons = 0;
 
 
 auto mouse::x() -> int { return mouse_x; }
 auto mouse::y() -> int { return mouse_y; }
 auto mouse::prevx() -> int { return mouse_prevx; }
 auto mouse::prevy() -> int { return mouse_prevy; }
-auto mouse::pressed() -> bool { return mouse_pressed; }
+auto mouse::pressed() -> bool { return mouse_buttons != 0; }
+auto mouse::moved() -> bool { return mouse_x != mouse_prevx || mouse_y != mouse_prevy; }
 
 
 auto mouse::update(SDL_Event const& event) -> void {
-    // If mouse event happened
+    // The events carry their own coordinates, so there's no need to ask SDL for the live state
     if (event.type == SDL_MOUSEMOTION) {
-        SDL_GetMouseState(&mouse_x, &mouse_y);
+        mouse_prevx = mouse_x;
+        mouse_prevy = mouse_y;
+        mouse_x = event.motion.x;
+        mouse_y = event.motion.y;
     } else if (event.type == SDL_MOUSEBUTTONDOWN) {
-        mouse_pressed = true;
+        mouse_buttons |= SDL_BUTTON(event.button.button);
     } else if (event.type == SDL_MOUSEBUTTONUP) {
-        mouse_pressed = false;
+        mouse_buttons &= ~static_cast<Uint32>(SDL_BUTTON(event.button.button));
     }
 }
@@ -0,0 +1,282 @@
+#include <SDL2/SDL.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#include "helpers/Clock.hpp"
+#include "helpers/replay.hpp"
+
+using std::cout;
+
+/*
+ * File layout: the magic header followed by tagged records in the order they were observed.
+ *   'E' <length byte> <event bytes>  event with trailing zero bytes trimmed
+ *   'S' <length byte> <event bytes> <varint length> <text>
+ *                                    event owning an SDL_malloc'd string, stored with its pointer zeroed
+ *   'T' <varint>                     ticks as a zigzag delta from the previous tick record
+ *   'F'                              the poll loop drained the queue, ends a frame
+ */
+static char const MAGIC[8] = {'S', 'D', 'L', 'R', 'P', 'L', 'Y', '1'};
+
+static auto replay_mode     = replay::Mode::off;
+static auto replay_desyncs  = 0;
+static auto last_ticks      = Uint32{0};
+static auto sent_quit       = false;
+
+static auto output          = std::ofstream{};
+static auto input           = std::vector<char>{};
+static auto input_pos       = std::size_t{0};
+
+
+static auto writeVarint(Uint32 value) -> void {
+    while (value >= 0x80) {
+        output.put(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    output.put(static_cast<char>(value));
+}
+
+static auto readVarint() -> Uint32 {
+    auto value = Uint32{0};
+    for (auto shift = 0; input_pos < input.size() && shift < 35; shift += 7) {
+        auto byte = static_cast<unsigned char>(input[input_pos++]);
+        value |= static_cast<Uint32>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) { break; }
+    }
+    return value;
+}
+
+static auto peekTag() -> char {
+    return input_pos < input.size() ? input[input_pos] : '\0';
+}
+
+
+/** The string field of events that hand the program a string it has to SDL_free */
+static auto ownedText(SDL_Event* event) -> char** {
+    switch (event->type) {
+        case SDL_DROPFILE:
+        case SDL_DROPTEXT:
+            return &event->drop.file;
+#if SDL_VERSION_ATLEAST(2, 0, 22)
+        case SDL_TEXTEDITING_EXT:
+            return &event->editExt.text;
+#endif
+        default:
+            return nullptr;
+    }
+}
+
+/** User and window manager events carry pointers that mean nothing to another run */
+static auto recordable(SDL_Event const& event) -> bool {
+    return event.type != SDL_SYSWMEVENT && event.type < SDL_USEREVENT;
+}
+
+static auto writeEvent(char tag, SDL_Event const& event) -> void {
+    auto bytes  = reinterpret_cast<char const*>(&event);
+    auto length = sizeof(SDL_Event);
+    while (length > 0 && bytes[length-1] == 0) {
+        length--;
+    }
+    output.put(tag);
+    output.put(static_cast<char>(length));
+    output.write(bytes, static_cast<std::streamsize>(length));
+}
+
+/** Reads an 'E' or 'S' record, false if the recording ends partway through it */
+static auto readEvent(SDL_Event* event) -> bool {
+    if (input.size() - input_pos < 2) {
+        return false;
+    }
+    auto tag    = input[input_pos];
+    auto length = static_cast<std::size_t>(static_cast<unsigned char>(input[input_pos + 1]));
+    if (length > sizeof(SDL_Event) || input.size() - input_pos - 2 < length) {
+        return false;
+    }
+
+    input_pos += 2;
+    std::memset(event, 0, sizeof(SDL_Event));
+    std::memcpy(event, input.data() + input_pos, length);
+    input_pos += length;
+    if (tag != 'S') {
+        return true;
+    }
+
+    auto text = ownedText(event);
+    if (!text || input_pos >= input.size()) {
+        return false;
+    }
+    auto text_length = static_cast<std::size_t>(readVarint());
+    if (input.size() - input_pos < text_length) {
+        return false;
+    }
+
+    // The program frees these with SDL_free, just as it would SDL's own
+    auto copy = static_cast<char*>(SDL_malloc(text_length + 1));
+    if (!copy) {
+        return false;
+    }
+    std::memcpy(copy, input.data() + input_pos, text_length);
+    copy[text_length] = '\0';
+    input_pos += text_length;
+    *text = copy;
+    return true;
+}
+
+
+auto replay::mode() -> Mode { return replay_mode; }
+auto replay::desyncs() -> int { return replay_desyncs; }
+
+
+auto replay::startRecording(char const* file_name) -> bool {
+    stop();
+
+    output.open(file_name, std::ios::binary | std::ios::trunc);
+    if (!output) {
+        cout << "Unable to open " << file_name << " for recording.\n";
+        return false;
+    }
+
+    output.write(MAGIC, sizeof(MAGIC));
+    replay_mode = Mode::record;
+    return true;
+}
+
+auto replay::startReplay(char const* file_name) -> bool {
+    stop();
+
+    auto file = std::ifstream{file_name, std::ios::binary};
+    if (!file) {
+        cout << "Unable to open recording " << file_name << ".\n";
+        return false;
+    }
+
+    input.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+    if (input.size() < sizeof(MAGIC) || std::memcmp(input.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        cout << file_name << " is not a recording.\n";
+        input.clear();
+        return false;
+    }
+
+    input_pos   = sizeof(MAGIC);
+    replay_mode = Mode::replay;
+    return true;
+}
+
+/** TUTORIAL_RECORD=<file> records a session, TUTORIAL_REPLAY=<file> replays one headlessly */
+auto replay::initFromEnvironment() -> bool {
+    if (auto file_name = std::getenv("TUTORIAL_REPLAY")) {
+        // Replays don't need to be seen or heard, and shouldn't wait on vsync
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+        SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
+        SDL_SetHint(SDL_HINT_RENDER_VSYNC, "0");
+        return startReplay(file_name);
+    }
+    if (auto file_name = std::getenv("TUTORIAL_RECORD")) {
+        return startRecording(file_name);
+    }
+    return true;
+}
+
+auto replay::stop() -> void {
+    if (output.is_open()) {
+        output.close();
+    }
+    input.clear();
+    input_pos      = 0;
+    last_ticks     = 0;
+    replay_desyncs = 0;
+    sent_quit      = false;
+    replay_mode    = Mode::off;
+}
+
+
+/** Drop-in replacement for SDL_PollEvent */
+auto replay::pollEvent(SDL_Event* event) -> int {
+    if (replay_mode == Mode::record) {
+        auto result = SDL_PollEvent(event);
+        if (!result) {
+            output.put('F');
+        } else if (auto text = ownedText(event); text && *text) {
+            auto stored = *event;
+            *ownedText(&stored) = nullptr;
+            writeEvent('S', stored);
+
+            auto length = std::strlen(*text);
+            writeVarint(static_cast<Uint32>(length));
+            output.write(*text, static_cast<std::streamsize>(length));
+        } else if (recordable(*event)) {
+            writeEvent('E', *event);
+        }
+        return result;
+    }
+
+    if (replay_mode == Mode::replay) {
+        // Drain the real queue so the OS doesn't think the window is hung
+        auto discarded = SDL_Event{};
+        while (SDL_PollEvent(&discarded)) {}
+
+        while (peekTag() == 'T') {
+            replay_desyncs++;
+            input_pos++;
+            readVarint();
+        }
+
+        switch (peekTag()) {
+            case 'F':
+                input_pos++;
+                return 0;
+            case 'E':
+            case 'S':
+                if (readEvent(event)) {
+                    return 1;
+                }
+                cout << "Recording ends partway through an event, stopping the replay.\n";
+                input_pos = input.size();
+                [[fallthrough]];
+            default:
+                // Recording exhausted, ask the program to quit exactly once
+                if (sent_quit) {
+                    return 0;
+                }
+                sent_quit = true;
+                std::memset(event, 0, sizeof(SDL_Event));
+                event->type = SDL_QUIT;
+                return 1;
+        }
+    }
+
+    return SDL_PollEvent(event);
+}
+
+/** Passes live ticks through while recording, substitutes the recorded ticks while replaying */
+auto replay::observeTicks(Uint32 ticks) -> Uint32 {
+    if (replay_mode == Mode::record) {
+        auto delta = static_cast<Sint32>(ticks - last_ticks);
+        output.put('T');
+        writeVarint((static_cast<Uint32>(delta) << 1) ^ static_cast<Uint32>(delta >> 31));
+        last_ticks = ticks;
+        return ticks;
+    }
+
+    if (replay_mode == Mode::replay) {
+        if (peekTag() != 'T') {
+            replay_desyncs++;
+            return last_ticks;
+        }
+        input_pos++;
+        auto zigzag = readVarint();
+        last_ticks += static_cast<Uint32>(static_cast<Sint32>(zigzag >> 1) ^ -static_cast<Sint32>(zigzag & 1));
+        return last_ticks;
+    }
+
+    return ticks;
+}
+
+/** The real clock's ticks rather than SDL_GetTicks, so every recorded tick shares one epoch */
+auto replay::getTicks() -> Uint32 {
+    return Clock::real().ticks();
+}
@@ -0,0 +1,179 @@
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "helpers/inventory.hpp"
+#include "helpers/residency.hpp"
+#include "helpers/Profiler.hpp"
+
+
+namespace {
+    struct Entry {
+        SDL_Texture*                         texture;
+        Uint64                               last_used;
+        residency::ResidentTexture::Loader   load;
+        bool                                 failed;
+    };
+}
+
+static constexpr auto NO_SLOT = std::numeric_limits<std::size_t>::max();
+
+static auto texture_sizes   = std::unordered_map<SDL_Texture*, Uint64>{};
+static auto entries         = std::vector<Entry>{};
+static auto free_slots      = std::vector<std::size_t>{};
+
+static auto total_bytes     = Uint64{0};
+static auto peak_bytes      = Uint64{0};
+static auto budget_bytes    = Uint64{0};
+static auto evictions       = Uint64{0};
+static auto restores        = Uint64{0};
+static auto current_frame   = Uint64{1};
+
+
+/** Drops the least recently used resident textures until the total fits, skipping anything used this frame */
+static auto enforceBudget() -> void {
+    while (budget_bytes != 0 && total_bytes > budget_bytes) {
+        auto victim = NO_SLOT;
+        for (auto slot = std::size_t{0}; slot < entries.size(); slot++) {
+            auto const& entry = entries[slot];
+            if (entry.texture && entry.last_used < current_frame &&
+                (victim == NO_SLOT || entry.last_used < entries[victim].last_used)) {
+                victim = slot;
+            }
+        }
+        if (victim == NO_SLOT) {
+            return;
+        }
+
+        residency::destroyTexture(std::exchange(entries[victim].texture, nullptr));
+        evictions++;
+    }
+}
+
+static auto load(Entry& entry) -> SDL_Texture* {
+    auto texture = entry.load();
+    if (texture && !texture_sizes.contains(texture)) {
+        residency::track(texture);
+    }
+    entry.texture = texture;
+    entry.failed  = !texture;
+    return texture;
+}
+
+
+auto residency::textureBytes(SDL_Texture* texture) -> Uint64 {
+    auto format = Uint32{0};
+    auto w      = 0;
+    auto h      = 0;
+    if (!texture || SDL_QueryTexture(texture, &format, nullptr, &w, &h) != 0) {
+        return 0;
+    }
+    return static_cast<Uint64>(w) * static_cast<Uint64>(h) * SDL_BYTESPERPIXEL(format);
+}
+
+auto residency::track(SDL_Texture* texture) -> SDL_Texture* {
+    if (!texture) {
+        return texture;
+    }
+
+    auto& bytes = texture_sizes[texture];
+    total_bytes -= bytes;
+    bytes        = textureBytes(texture);
+    total_bytes += bytes;
+    peak_bytes   = std::max(peak_bytes, total_bytes);
+    return texture;
+}
+
+auto residency::destroyTexture(SDL_Texture* texture) -> void {
+    if (!texture) {
+        return;
+    }
+
+    auto found = texture_sizes.find(texture);
+    if (found != texture_sizes.end()) {
+        total_bytes -= found->second;
+        texture_sizes.erase(found);
+    }
+    inventory::remove(texture);
+    SDL_DestroyTexture(texture);
+}
+
+auto residency::setBudget(Uint64 bytes) -> void {
+    budget_bytes = bytes;
+    enforceBudget();
+}
+
+auto residency::beginFrame() -> void {
+    PROFILE_FUNCTION();
+
+    current_frame++;
+    enforceBudget();
+}
+
+auto residency::stats() -> Stats {
+    return {total_bytes, peak_bytes, budget_bytes, evictions, restores, texture_sizes.size()};
+}
+
+
+residency::ResidentTexture::ResidentTexture(): slot_(NO_SLOT) {}
+
+residency::ResidentTexture::ResidentTexture(Loader load): slot_(NO_SLOT) {
+    if (free_slots.empty()) {
+        slot_ = entries.size();
+        entries.push_back(Entry{});
+    } else {
+        slot_ = free_slots.back();
+        free_slots.pop_back();
+    }
+
+    // Not marked as used, so loading a whole asset set up front still settles under the budget
+    entries[slot_] = Entry{nullptr, 0, std::move(load), false};
+    ::load(entries[slot_]);
+    enforceBudget();
+}
+
+residency::ResidentTexture::~ResidentTexture() {
+    if (slot_ == NO_SLOT) {
+        return;
+    }
+    destroyTexture(entries[slot_].texture);
+    entries[slot_] = Entry{};
+    free_slots.push_back(slot_);
+}
+
+residency::ResidentTexture::ResidentTexture(ResidentTexture&& other): slot_(std::exchange(other.slot_, NO_SLOT)) {}
+
+auto residency::ResidentTexture::operator=(ResidentTexture&& other) -> ResidentTexture& {
+    // The old slot goes with the temporary
+    auto taken = ResidentTexture{std::move(other)};
+    std::swap(slot_, taken.slot_);
+    return *this;
+}
+
+residency::ResidentTexture::operator bool() const { return slot_ != NO_SLOT && !entries[slot_].failed; }
+
+auto residency::ResidentTexture::resident() const -> bool { return slot_ != NO_SLOT && entries[slot_].texture; }
+
+auto residency::ResidentTexture::get() -> SDL_Texture* {
+    if (slot_ == NO_SLOT) {
+        return nullptr;
+    }
+
+    auto& entry = entries[slot_];
+    entry.last_used = current_frame;
+    if (!entry.texture && ::load(entry)) {
+        restores++;
+        enforceBudget();
+    }
+    return entries[slot_].texture;
+}
+
+auto residency::ResidentTexture::view() -> TextureView { return TextureView{get()}; }
+
+auto residency::ResidentTexture::render(SDL_Renderer* renderer, SDL_Rect* clip) -> void {
+    view().render(renderer, clip);
+}
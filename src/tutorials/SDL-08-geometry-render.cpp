@@ -63,7 +63,7 @@ auto run() -> bool {
 
     while (!quit) {
         // Handle events on queue
-        while (SDL_PollEvent(&event) != 0) {
+        while (replay::pollEvent(&event) != 0) {
             //  User requests quit
             if (event.type == SDL_QUIT) {
                 quit = true;
@@ -28,7 +28,7 @@ struct ProgramData {
     ManagedSDLSurface       screen_surface;
     ManagedSDLRenderer      renderer;
     ManagedSDLTexture       sprite_sheet;
-    std::array<TextureComponent, 4> sprite_clips;
+    ecs::World              world;
 };
 
 struct color {
@@ -71,7 +71,7 @@ auto run() -> bool {
 
     while (!quit) {
         // Handle events on queue
-        while (SDL_PollEvent(&event) != 0) {
+        while (replay::pollEvent(&event) != 0) {
             //  User requests quit
             if (event.type == SDL_QUIT) {
                 quit = true;
@@ -82,17 +82,8 @@ auto run() -> bool {
         SDL_SetRenderDrawColor(data.renderer, 0xFF, 0xFF, 0xFF, 0xFF);
         SDL_RenderClear(data.renderer);
 
-        // Render top left sprite
-        data.sprite_clips[0].render(data.renderer);
-
-        // Render top right sprite
-        data.sprite_clips[1].render(data.renderer);
-
-        // Render bottom left sprite
-        data.sprite_clips[2].render(data.renderer);
-
-        // Render bottom right sprite
-        data.sprite_clips[3].render(data.renderer);
+        // Render all four corner sprites
+        ecs::renderSprites(data.world, data.renderer);
 
         // Update screen
         SDL_RenderPresent(data.renderer);
@@ -174,10 +165,15 @@ auto loadMedia(ProgramData& data) -> bool {
     // //Render bottom right sprite
     // gSpriteSheetTexture.render(SCREEN_WIDTH - gSpriteClips[3].w, SCREEN_HEIGHT - gSpriteClips[3].h, &gSpriteClips[3]);
 
-    data.sprite_clips[0] = TextureComponent{ManagedSDLTexture{data.sprite_sheet, SDL_Rect{  0,   0, 100, 100}}, {               0,                 0, 100, 100}};
-    data.sprite_clips[1] = TextureComponent{ManagedSDLTexture{data.sprite_sheet, SDL_Rect{100,   0, 100, 100}}, {SCREEN_WIDTH-100,                 0, 100, 100}};
-    data.sprite_clips[2] = TextureComponent{ManagedSDLTexture{data.sprite_sheet, SDL_Rect{  0, 100, 100, 100}}, {               0, SCREEN_HEIGHT-100, 100, 100}};
-    data.sprite_clips[3] = TextureComponent{ManagedSDLTexture{data.sprite_sheet, SDL_Rect{100, 100, 100, 100}}, {SCREEN_WIDTH-100, SCREEN_HEIGHT-100, 100, 100}};
+    auto corner = [&data](SDL_Rect const& source, float x, float y) {
+        data.world.create(ecs::Transform{x, y, 0.0},
+                          ecs::Sprite{data.sprite_sheet.view(source), {0, 0, source.w, source.h}});
+    };
+
+    corner({  0,   0, 100, 100},                0,                 0);
+    corner({100,   0, 100, 100}, SCREEN_WIDTH-100,                 0);
+    corner({  0, 100, 100, 100},                0, SCREEN_HEIGHT-100);
+    corner({100, 100, 100, 100}, SCREEN_WIDTH-100, SCREEN_HEIGHT-100);
 
     return true;
 }
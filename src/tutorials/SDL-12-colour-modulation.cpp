@@ -23,6 +23,9 @@ const int SCREEN_WIDTH = 640;
 const int SCREEN_HEIGHT = 480;
 
 
+enum ColourAction: ActionMap::Action { RED_UP, GREEN_UP, BLUE_UP, RED_DOWN, GREEN_DOWN, BLUE_DOWN };
+
+
 struct ProgramData {
     ManagedSDLWindow    window;
     ManagedSDLSurface   screen_surface;
@@ -48,8 +51,10 @@ auto run() -> bool {
 
     auto modulation = SDL_Colour{0xFF, 0xFF, 0xFF, 0};
 
-    auto event  = SDL_Event{};
-    auto quit   = false;
+    auto event      = SDL_Event{};
+    auto quit       = false;
+    auto input      = InputBuilder{};
+    auto actions    = ActionMap{};
 
     auto stretchRect = SDL_Rect{};
     stretchRect.x = 0;
@@ -67,48 +72,34 @@ auto run() -> bool {
         return false;
     }
 
+    actions.bind(RED_UP,     {SDL_SCANCODE_Q})
+           .bind(GREEN_UP,   {SDL_SCANCODE_W})
+           .bind(BLUE_UP,    {SDL_SCANCODE_E})
+           .bind(RED_DOWN,   {SDL_SCANCODE_A})
+           .bind(GREEN_DOWN, {SDL_SCANCODE_S})
+           .bind(BLUE_DOWN,  {SDL_SCANCODE_D});
+
     while (!quit) {
         // Handle events on queue
-        while (SDL_PollEvent(&event) != 0) {
+        input.beginFrame();
+        while (replay::pollEvent(&event) != 0) {
             //  User requests quit
             if (event.type == SDL_QUIT) {
                 quit = true;
-            } else if (event.type == SDL_KEYDOWN) {
-                // On keypress change rgb values
-                switch (event.key.keysym.sym) {
-                    // Increase red
-                    case SDLK_q:
-                        modulation.r += std::min<Uint8>(32, 255-modulation.r);
-                        break;
-
-                    // Increase green
-                    case SDLK_w:
-                        modulation.g += std::min<Uint8>(32, 255-modulation.g);
-                        break;
-
-                    // Increase blue
-                    case SDLK_e:
-                        modulation.b += std::min<Uint8>(32, 255-modulation.b);
-                        break;
-
-                    // Decrease red
-                    case SDLK_a:
-                        modulation.r -= std::min<Uint8>(32, modulation.r);
-                        break;
-
-                    // Decrease green
-                    case SDLK_s:
-                        modulation.g -= std::min<Uint8>(32, modulation.g);
-                        break;
-
-                    // Decrease blue
-                    case SDLK_d:
-                        modulation.b -= std::min<Uint8>(32, modulation.b);
-                        break;
-                }
             }
+
+            input.feed(event);
         }
 
+        // On keypress change rgb values
+        actions.update(input.snapshot());
+        if (actions.pressed(RED_UP))     { modulation.r += std::min<Uint8>(32, 255-modulation.r); }
+        if (actions.pressed(GREEN_UP))   { modulation.g += std::min<Uint8>(32, 255-modulation.g); }
+        if (actions.pressed(BLUE_UP))    { modulation.b += std::min<Uint8>(32, 255-modulation.b); }
+        if (actions.pressed(RED_DOWN))   { modulation.r -= std::min<Uint8>(32, modulation.r); }
+        if (actions.pressed(GREEN_DOWN)) { modulation.g -= std::min<Uint8>(32, modulation.g); }
+        if (actions.pressed(BLUE_DOWN))  { modulation.b -= std::min<Uint8>(32, modulation.b); }
+
         // Clear screen
         SDL_SetRenderDrawColor(data.renderer, 0xFF, 0xFF, 0xFF, 0xFF);
         SDL_RenderClear(data.renderer);
@@ -29,9 +29,10 @@ struct ProgramData {
     ManagedSDLWindow        window;
     ManagedSDLSurface       screen_surface;
     ManagedSDLRenderer      renderer;
-    ManagedSDLTexture       sprite_sheet;
+    ResourceRegistry        resources;
+    TextureHandle           sprite_sheet;
 
-    std::array<ManagedSDLTexture, WALKING_ANIMATION_FRAMES> sprite_clips;
+    std::array<TextureView, WALKING_ANIMATION_FRAMES> sprite_clips;
 };
 
 
@@ -68,14 +69,16 @@ auto run() -> bool {
         return false;
     }
 
-    auto rect = SDL_Rect{(SCREEN_WIDTH  - data.sprite_sheet.rect().w/ProgramData::WALKING_ANIMATION_FRAMES) / 2,
-                         (SCREEN_HEIGHT - data.sprite_sheet.rect().h) / 2,
-                         data.sprite_sheet.rect().w/ProgramData::WALKING_ANIMATION_FRAMES,
-                         data.sprite_sheet.rect().h};
+    auto sheet = data.sprite_clips[0].baseDim();
+
+    auto rect = SDL_Rect{(SCREEN_WIDTH  - sheet.x/ProgramData::WALKING_ANIMATION_FRAMES) / 2,
+                         (SCREEN_HEIGHT - sheet.y) / 2,
+                         sheet.x/ProgramData::WALKING_ANIMATION_FRAMES,
+                         sheet.y};
 
     while (!quit) {
         // Handle events on queue
-        while (SDL_PollEvent(&event) != 0) {
+        while (replay::pollEvent(&event) != 0) {
             //  User requests quit
             if (event.type == SDL_QUIT) {
                 quit = true;
@@ -162,13 +165,15 @@ auto loadMedia(ProgramData& data) -> bool {
     SDL_SetRenderDrawColor(data.renderer, 0xFF, 0xFF, 0xFF, 0xFF);
 
     auto cyan = SDL_Colour{0, 0xff, 0xff, 0};
-    data.sprite_sheet = ManagedSDLTexture{loadTextureFromFile(data.renderer, "images/t14/foo.png", cyan)};
+    data.sprite_sheet = data.resources.textures.acquire(loadTextureFromFile(data.renderer, "images/t14/foo.png", cyan));
     if (!data.sprite_sheet) { return false; }
 
-    data.sprite_clips[0] = ManagedSDLTexture{data.sprite_sheet, SDL_Rect{  0, 0, 64, 205}};
-    data.sprite_clips[1] = ManagedSDLTexture{data.sprite_sheet, SDL_Rect{ 64, 0, 64, 205}};
-    data.sprite_clips[2] = ManagedSDLTexture{data.sprite_sheet, SDL_Rect{128, 0, 64, 205}};
-    data.sprite_clips[3] = ManagedSDLTexture{data.sprite_sheet, SDL_Rect{196, 0, 64, 205}};
+    // Clips are non-owning views, the registry keeps the sheet alive for as long as they're used
+    auto sheet = TextureView{data.resources.textures[data.sprite_sheet]};
+    data.sprite_clips[0] = sheet.sub(SDL_Rect{  0, 0, 64, 205});
+    data.sprite_clips[1] = sheet.sub(SDL_Rect{ 64, 0, 64, 205});
+    data.sprite_clips[2] = sheet.sub(SDL_Rect{128, 0, 64, 205});
+    data.sprite_clips[3] = sheet.sub(SDL_Rect{196, 0, 64, 205});
 
     return true;
 }
@@ -35,6 +35,7 @@ struct ProgramData {
     ManagedSDLSurface   screen_surface;
     ManagedSDLRenderer  renderer;
     ManagedSDLTexture   sprite_sheet;
+    // Buttons only view the sheet, so they're declared after it and destroyed first
     std::vector<Button> buttons;
 };
 
@@ -54,7 +55,8 @@ int main(__attribute__((unused))int argc, __attribute__((unused))char *argv[]) {
 
 auto run() -> bool {
     auto data       = ProgramData{};
-    auto event      = SDL_Event{};
+    auto events     = EventDispatcher{};
+    auto input      = InputBuilder{};
     auto quit       = false;
 
     if (!init()) {
@@ -67,20 +69,25 @@ auto run() -> bool {
         return false;
     }
 
+    //  User requests quit
+    events.on(SDL_QUIT, [&quit](SDL_Event const&) { quit = true; });
+
+    // The buttons only care where the mouse ended up, so one motion event per frame is plenty
+    events.coalesceMotion(true, false);
+    events.onAny([&input](SDL_Event const& event) { input.feed(event); });
+
+    // The button vector is complete, so pointers into it stay valid
+    auto hits = HitGrid<Button>{SCREEN_WIDTH, SCREEN_HEIGHT};
+    for (auto& b: data.buttons) {
+        hits.insert(b);
+    }
+
     while (!quit) {
         // Handle events on queue
-        while (SDL_PollEvent(&event) != 0) {
-            //  User requests quit
-            if (event.type == SDL_QUIT) {
-                quit = true;
-            }
-
-            mouse::update(event);
-        }
+        input.beginFrame();
+        events.dispatch();
 
-        for (auto& b: data.buttons) {
-            b.update();
-        }
+        hits.update(input.snapshot());
 
         // Clear screen
         SDL_SetRenderDrawColor(data.renderer, 0xFF, 0xFF, 0xFF, 0xFF);
@@ -130,19 +137,21 @@ auto loadData(ProgramData& data) -> bool {
             SDL_Rect{0, 400, BUTTON_WIDTH, BUTTON_HEIGHT},
         };
 
-    auto screen_clips = std::array<SDL_Rect, 4> {
-            SDL_Rect{             0,               0, SCREEN_WIDTH/2, SCREEN_HEIGHT/2},
-            SDL_Rect{SCREEN_WIDTH/2,               0, SCREEN_WIDTH/2, SCREEN_HEIGHT/2},
-            SDL_Rect{             0, SCREEN_HEIGHT/2, SCREEN_WIDTH/2, SCREEN_HEIGHT/2},
-            SDL_Rect{SCREEN_WIDTH/2, SCREEN_HEIGHT/2, SCREEN_WIDTH/2, SCREEN_HEIGHT/2}
-        };
-
     for (auto i=0; i<TOTAL_BUTTONS; i++) {
-        data.buttons.push_back(Button{ManagedSDLTexture{data.sprite_sheet, source_clips[0]},
-                                      ManagedSDLTexture{data.sprite_sheet, source_clips[1]},
-                                      ManagedSDLTexture{data.sprite_sheet, source_clips[2]},
-                                      screen_clips[i]});
+        data.buttons.push_back(Button{data.sprite_sheet.view(source_clips[0]),
+                                      data.sprite_sheet.view(source_clips[1]),
+                                      data.sprite_sheet.view(source_clips[2]),
+                                      SDL_Rect{0, 0, BUTTON_WIDTH, BUTTON_HEIGHT}});
+    }
+
+    // One button per quadrant of the screen
+    auto layout  = Layout{{0, 0, SCREEN_WIDTH, SCREEN_HEIGHT}};
+    auto buttons = layout.grid(layout.root(), 2, 2);
+    layout.fill(buttons);
+    for (auto& b: data.buttons) {
+        layout.leaf(buttons, b, b.dim());
     }
+    layout.update();
 
     return true;
 }
@@ -24,17 +24,22 @@ using std::cout;
 const int SCREEN_WIDTH = 640;
 const int SCREEN_HEIGHT = 480;
 
+// Only one direction shows at a time, so two full screen images is plenty
+const Uint64 TEXTURE_BUDGET = 2 * SCREEN_WIDTH * SCREEN_HEIGHT * 4;
+
+enum Direction: ActionMap::Action { UP, DOWN, LEFT, RIGHT };
+
 
 struct ProgramData {
     ManagedSDLWindow    window;
     ManagedSDLSurface   screen_surface;
     ManagedSDLRenderer  renderer;
 
-    ManagedSDLTexture   texture_default;
-    ManagedSDLTexture   texture_up;
-    ManagedSDLTexture   texture_down;
-    ManagedSDLTexture   texture_left;
-    ManagedSDLTexture   texture_right;
+    residency::ResidentTexture  texture_default;
+    residency::ResidentTexture  texture_up;
+    residency::ResidentTexture  texture_down;
+    residency::ResidentTexture  texture_left;
+    residency::ResidentTexture  texture_right;
 };
 
 
@@ -55,6 +60,8 @@ auto run() -> bool {
     auto data       = ProgramData{};
     auto event      = SDL_Event{};
     auto quit       = false;
+    auto input      = InputBuilder{};
+    auto actions    = ActionMap{};
 
     auto current_texture = &data.texture_default;
 
@@ -63,30 +70,41 @@ auto run() -> bool {
         return false;
     }
 
+    residency::setBudget(TEXTURE_BUDGET);
+
     if (!loadData(data)) {
         cout << "Failed to load data.\n";
         return false;
     }
 
+    actions.bind(UP,    {SDL_SCANCODE_UP})
+           .bind(DOWN,  {SDL_SCANCODE_DOWN})
+           .bind(LEFT,  {SDL_SCANCODE_LEFT})
+           .bind(RIGHT, {SDL_SCANCODE_RIGHT});
+
     while (!quit) {
+        residency::beginFrame();
+
         // Handle events on queue
-        while (SDL_PollEvent(&event) != 0) {
+        input.beginFrame();
+        while (replay::pollEvent(&event) != 0) {
             //  User requests quit
             if (event.type == SDL_QUIT) {
                 quit = true;
             }
 
+            input.feed(event);
             mouse::update(event);
         }
 
-        auto currentKeyStates = SDL_GetKeyboardState(NULL);
-        if (currentKeyStates[SDL_SCANCODE_UP]) {
+        actions.update(input.snapshot());
+        if (actions.held(UP)) {
             current_texture = &data.texture_up;
-        } else if (currentKeyStates[SDL_SCANCODE_DOWN]) {
+        } else if (actions.held(DOWN)) {
             current_texture = &data.texture_down;
-        } else if (currentKeyStates[SDL_SCANCODE_LEFT]) {
+        } else if (actions.held(LEFT)) {
             current_texture = &data.texture_left;
-        } else if (currentKeyStates[SDL_SCANCODE_RIGHT]) {
+        } else if (actions.held(RIGHT)) {
             current_texture = &data.texture_right;
         } else {
             current_texture = &data.texture_default;
@@ -129,19 +147,19 @@ auto loadData(ProgramData& data) -> bool {
     // Get window surface
     data.screen_surface = SDL_GetWindowSurface(data.window);
 
-    data.texture_default = loadTextureFromFile(data.renderer, "images/t18/press.png");
+    data.texture_default = loadResidentTexture(data.renderer, "images/t18/press.png");
     if (!data.texture_default) { return false; }
 
-    data.texture_up = loadTextureFromFile(data.renderer, "images/t18/up.png");
+    data.texture_up = loadResidentTexture(data.renderer, "images/t18/up.png");
     if (!data.texture_up) { return false; }
 
-    data.texture_down = loadTextureFromFile(data.renderer, "images/t18/down.png");
+    data.texture_down = loadResidentTexture(data.renderer, "images/t18/down.png");
     if (!data.texture_down) { return false; }
 
-    data.texture_left = loadTextureFromFile(data.renderer, "images/t18/left.png");
+    data.texture_left = loadResidentTexture(data.renderer, "images/t18/left.png");
     if (!data.texture_left) { return false; }
 
-    data.texture_right = loadTextureFromFile(data.renderer, "images/t18/right.png");
+    data.texture_right = loadResidentTexture(data.renderer, "images/t18/right.png");
     if (!data.texture_right) { return false; }
 
 
@@ -13,7 +13,6 @@
 
 #include <chrono> // NOLINT [build/c++11]
 #include <thread> // NOLINT [build/c++11]
-#include <sstream>
 
 #include "SDL_helpers.hpp"
 #include "SDL_components.hpp"
@@ -31,7 +30,7 @@ struct ProgramData {
     ManagedSDLSurface   screen_surface;
     ManagedSDLRenderer  renderer;
 
-    ManagedSDLTexture   texture_time;
+    GlyphStrip          glyphs;
     ManagedSDLTexture   texture_prompt;
 
     ManagedTTFFont      font;
@@ -41,6 +40,10 @@ struct ProgramData {
 auto run() -> bool;
 auto loadData(ProgramData&) -> bool;
 
+auto keepTime(Scheduler& scheduler, HudText& time_text, Uint32 const& start_time) -> Task;
+auto resetOnEnter(Scheduler& scheduler, Uint32& start_time) -> Task;
+auto blinkPrompt(Scheduler& scheduler, Completion& loaded, bool& show_prompt) -> Task;
+
 
 int main(__attribute__((unused))int argc, __attribute__((unused))char *argv[]) {
     run();
@@ -57,69 +60,68 @@ auto run() -> bool {
     auto quit       = false;
     auto last_frame = Uint32{0};
 
-    auto black      = SDL_Colour{0, 0, 0, 0xff};
-    auto start_time = Uint32{0};
-    auto time_text  = std::stringstream{};
+    auto black          = SDL_Colour{0, 0, 0, 0xff};
+    auto start_time     = Uint32{0};
+    auto time_text      = HudText{};
+    auto show_prompt    = false;
+    auto arena          = FrameArena{};
+    auto loaded         = Completion{};
 
     if (!init()) {
         cout << "Failed to initialize.\n";
         return false;
     }
 
+    // Declared after everything the coroutines reference, so its suspended coroutines are destroyed first
+    auto scheduler = Scheduler{};
+    keepTime(scheduler, time_text, start_time);
+    resetOnEnter(scheduler, start_time);
+    blinkPrompt(scheduler, loaded, show_prompt);
+
     if (!loadData(data)) {
         cout << "Failed to load data.\n";
         return false;
     }
+    loaded.complete();
 
     auto clip_prompt = SDL_Rect{(SCREEN_WIDTH-data.texture_prompt.rect().w) / 2,
                                 0,
                                 data.texture_prompt.rect().w,
                                 data.texture_prompt.rect().h};
 
-    auto clip_time   = SDL_Rect{(SCREEN_WIDTH-data.texture_time.rect().w) / 2,
-                                (SCREEN_HEIGHT-data.texture_time.rect().h) / 2,
-                                data.texture_time.rect().w,
-                                data.texture_time.rect().h};
-
     while (!quit) {
+        allocations::beginFrame();
+        // Debug builds stop here if the last frame still went to the heap once the loop has settled
+        allocations::expectSteady(arena.reset());
+
         // Handle events on queue
-        while (SDL_PollEvent(&event) != 0) {
+        while (replay::pollEvent(&event) != 0) {
             //  User requests quit
             if (event.type == SDL_QUIT) {
                 quit = true;
-            } else if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_RETURN) {
-                start_time = SDL_GetTicks();
-                // cout << "keydown: " << start_time << "\n";
             }
 
             mouse::update(event);
+            scheduler.dispatch(event);
         }
 
-        time_text.str("");
-        time_text << "Milliseconds since start time " << SDL_GetTicks() - start_time;
-
-        // Render text
-        data.texture_time = loadTextureFromText(data.renderer, time_text.str().c_str(), data.font, black);
-        if (!data.texture_time) {
-            cout << "Unable to render time texture.\n";
-        }
-
-        clip_time = SDL_Rect{(SCREEN_WIDTH-data.texture_time.rect().w) / 2,
-                             (SCREEN_HEIGHT-data.texture_time.rect().h) / 2,
-                             data.texture_time.rect().w,
-                             data.texture_time.rect().h};
+        // Fires due delays and resumes everything waiting on the next frame, before anything is drawn
+        scheduler.frame();
+        auto time_dim = data.glyphs.measure(time_text.text());
 
         // Clear screen
         SDL_SetRenderDrawColor(data.renderer, 0xFF, 0xFF, 0xFF, 0xFF);
         SDL_RenderClear(data.renderer);
 
-        data.texture_prompt.render(data.renderer, &clip_prompt);
-        data.texture_time.render(data.renderer, &clip_time);
+        if (show_prompt) {
+            data.texture_prompt.render(data.renderer, &clip_prompt);
+        }
+        data.glyphs.render(data.renderer, arena, time_text.text(), {(SCREEN_WIDTH-time_dim.x) / 2, (SCREEN_HEIGHT-time_dim.y) / 2}, black);
 
         // Update screen
         SDL_RenderPresent(data.renderer);
 
-        auto current_frame = SDL_GetTicks();
+        auto current_frame = replay::getTicks();
         std::this_thread::sleep_for(std::chrono::milliseconds(std::max(0, 30-static_cast<int>(current_frame-last_frame))));
         last_frame = current_frame;
     }
@@ -128,6 +130,36 @@ auto run() -> bool {
 }
 
 
+/** Rewrites the timer text once a frame */
+auto keepTime(Scheduler& scheduler, HudText& time_text, Uint32 const& start_time) -> Task {
+    while (true) {
+        // Drawn from the glyph strip, so a new number every frame rasterises nothing
+        time_text.clear().append("Milliseconds since start time ").append(replay::getTicks() - start_time);
+        co_await scheduler.nextFrame();
+    }
+}
+
+auto resetOnEnter(Scheduler& scheduler, Uint32& start_time) -> Task {
+    while (true) {
+        auto event = co_await scheduler.event(SDL_KEYDOWN);
+        if (event.key.keysym.sym == SDLK_RETURN) {
+            start_time = replay::getTicks();
+        }
+    }
+}
+
+/** Waits for the prompt texture, then shows it for a second and hides it for half of one, forever */
+auto blinkPrompt(Scheduler& scheduler, Completion& loaded, bool& show_prompt) -> Task {
+    co_await scheduler.loaded(loaded);
+    while (true) {
+        show_prompt = true;
+        co_await scheduler.delay(1000);
+        show_prompt = false;
+        co_await scheduler.delay(500);
+    }
+}
+
+
 auto loadData(ProgramData& data) -> bool {
     // Create window
     data.window = SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
@@ -154,5 +186,7 @@ auto loadData(ProgramData& data) -> bool {
     data.texture_prompt = loadTextureFromText(data.renderer, "Press Enter to Reset Start Time.", data.font, SDL_Colour{0, 0, 0, 0xff});
     if (!data.texture_prompt) { return false; }
 
+    if (!data.glyphs.build(data.renderer, data.font)) { return false; }
+
     return true;
 }
@@ -13,7 +13,6 @@
 
 #include <chrono> // NOLINT [build/c++11]
 #include <thread> // NOLINT [build/c++11]
-#include <sstream>
 
 #include "SDL_helpers.hpp"
 #include "SDL_components.hpp"
@@ -30,10 +29,12 @@ struct ProgramData {
     ManagedSDLWindow    window;
     ManagedSDLSurface   screen_surface;
     ManagedSDLRenderer  renderer;
+    StagingPool         staging;
+    ManagedSDLTexture   canvas;
 
-    ManagedSDLTexture   texture_time;
-    ManagedSDLTexture   texture_prompt_pause;
-    ManagedSDLTexture   texture_prompt_start;
+    TextureComponent    texture_time;
+    TextureComponent    texture_prompt_pause;
+    TextureComponent    texture_prompt_start;
 
     ManagedTTFFont      font;
 };
@@ -54,14 +55,18 @@ int main(__attribute__((unused))int argc, __attribute__((unused))char *argv[]) {
 
 auto run() -> bool {
     auto data       = ProgramData{};
-    auto event      = SDL_Event{};
+    auto events     = EventDispatcher{};
+    auto input      = InputBuilder{};
     auto quit       = false;
     auto last_frame = Uint32{0};
 
     auto black      = SDL_Colour{0, 0, 0, 0xff};
-    auto time_text  = std::stringstream{};
+    auto arena      = FrameArena{};
+    auto shown_time = Uint32{0};
 
     auto timer      = Timer{};
+    auto layout     = Layout{{0, 0, SCREEN_WIDTH, SCREEN_HEIGHT}};
+    auto ui         = WidgetTree{{0, 0, SCREEN_WIDTH, SCREEN_HEIGHT}};
 
     if (!init()) {
         cout << "Failed to initialize.\n";
@@ -73,71 +78,107 @@ auto run() -> bool {
         return false;
     }
 
-    auto clip_prompt_start = SDL_Rect{(SCREEN_WIDTH-data.texture_prompt_start.rect().w) / 2,
-                                      0,
-                                      data.texture_prompt_start.rect().w,
-                                      data.texture_prompt_start.rect().h};
+    // User requests quit
+    events.on(SDL_QUIT, [&quit](SDL_Event const&) { quit = true; });
 
-    auto clip_prompt_pause = SDL_Rect{(SCREEN_WIDTH-data.texture_prompt_pause.rect().w) / 2,
-                                      clip_prompt_start.h+10,
-                                      data.texture_prompt_pause.rect().w,
-                                      data.texture_prompt_pause.rect().h};
+    auto reset = [&timer]() { timer.reset(); };
+    auto toggle_pause = [&timer]() {
+        if (timer.paused()) {
+            timer.unpause();
+        } else {
+            timer.pause();
+        }
+    };
 
+    // reset
+    events.onKey(SDLK_s, [&reset](SDL_Event const&) { reset(); });
 
-    auto clip_time   = SDL_Rect{(SCREEN_WIDTH-data.texture_time.rect().w) / 2,
-                                (SCREEN_HEIGHT-data.texture_time.rect().h) / 2,
-                                data.texture_time.rect().w,
-                                data.texture_time.rect().h};
+    // Pause/unpause
+    events.onKey(SDLK_p, [&toggle_pause](SDL_Event const&) { toggle_pause(); });
 
-    while (!quit) {
-        // Handle events on queue
-        while (SDL_PollEvent(&event) != 0) {
-            // User requests quit
-            if (event.type == SDL_QUIT) {
-                quit = true;
-            } else if (event.type == SDL_KEYDOWN) {
-                // reset
-                if (event.key.keysym.sym == SDLK_s) {
-                    timer.reset();
-                // Pause/unpause
-                } else if (event.key.keysym.sym == SDLK_p) {
-                    if (timer.paused()) {
-                        timer.unpause();
-                    } else {
-                        timer.pause();
-                    }
-                }
-            }
+    events.onAny([&input](SDL_Event const& event) { input.feed(event); });
 
-            mouse::update(event);
+    for (auto type : {SDL_MOUSEMOTION, SDL_MOUSEBUTTONDOWN, SDL_MOUSEBUTTONUP}) {
+        events.on(type, mouse::update);
+    }
+
+    // The canvas only holds what was drawn into it, so anything that loses it or the window redraws the lot
+    events.on(SDL_RENDER_TARGETS_RESET, [&ui](SDL_Event const&) { ui.markDirty(); });
+    events.on(SDL_WINDOWEVENT, [&ui](SDL_Event const& event) {
+        if (event.window.event == SDL_WINDOWEVENT_EXPOSED) {
+            ui.markDirty();
         }
+    });
 
-        time_text.str("");
-        time_text << "Time elapsed: " << timer.elapsed();
+    timer.reset();
 
-        // Render text
-        data.texture_time = loadTextureFromText(data.renderer, time_text.str().c_str(), data.font, black);
-        if (!data.texture_time) {
-            cout << "Unable to render time texture.\n";
-        }
+    // Prompts stacked at the top centre, the time in the middle of the screen
+    auto prompts = layout.stack(layout.root(), Layout::Axis::vertical, 10);
+    layout.anchor(prompts, 0.5f, 0.0f);
+    layout.leaf(prompts, data.texture_prompt_start);
+    layout.leaf(prompts, data.texture_prompt_pause);
 
-        clip_time = SDL_Rect{(SCREEN_WIDTH-data.texture_time.rect().w) / 2,
-                             (SCREEN_HEIGHT-data.texture_time.rect().h) / 2,
-                             data.texture_time.rect().w,
-                             data.texture_time.rect().h};
+    auto time_node = layout.leaf(layout.root(), data.texture_time);
+    layout.anchor(time_node, 0.5f, 0.5f);
 
-        // Clear screen
-        SDL_SetRenderDrawColor(data.renderer, 0xFF, 0xFF, 0xFF, 0xFF);
-        SDL_RenderClear(data.renderer);
+    // The prompts can be clicked as well as typed
+    auto clicked = [](auto action) {
+        return [action](WidgetTree::Event const& event) {
+            if (event.type == WidgetTree::EventType::click) {
+                action();
+                return true;
+            }
+            return false;
+        };
+    };
+    ui.on(ui.add(ui.root(), data.texture_prompt_start), clicked(toggle_pause));
+    ui.on(ui.add(ui.root(), data.texture_prompt_pause), clicked(reset));
+    auto time_widget = ui.add(ui.root(), data.texture_time);
 
-        data.texture_prompt_start.render(data.renderer, &clip_prompt_start);
-        data.texture_prompt_pause.render(data.renderer, &clip_prompt_pause);
-        data.texture_time.render(data.renderer, &clip_time);
+    while (!quit) {
+        // Last frame's text has been turned into a texture, so its memory can be reused
+        arena.reset();
 
-        // Update screen
-        SDL_RenderPresent(data.renderer);
+        // Handle events on queue
+        input.beginFrame();
+        events.dispatch();
+        ui.update(input.snapshot());
+
+        // Paused time doesn't change, so nothing is rendered or redrawn for it
+        auto elapsed = timer.elapsed();
+        if (elapsed != shown_time || !data.texture_time.texture()) {
+            shown_time = elapsed;
+            auto time_text = arena.format("Time elapsed: %u", elapsed);
+
+            // Render text
+            // Last frame's texture goes back to the pool when it's replaced, so this stops creating textures after two frames
+            data.texture_time = data.staging.text(data.renderer, time_text.data(), data.font, black);
+            if (!data.texture_time.texture()) {
+                cout << "Unable to render time texture.\n";
+            }
+
+            // Only re-centres the time when the rendered text changes size
+            layout.contentChanged(time_node);
+            ui.markDirty(time_widget);
+        }
+        layout.update();
+
+        // Only what changed is redrawn into the canvas, and a frame where nothing changed presents nothing
+        if (ui.dirty()) {
+            SDL_SetRenderTarget(data.renderer, data.canvas);
+            SDL_SetRenderDrawColor(data.renderer, 0xFF, 0xFF, 0xFF, 0xFF);
+            for (auto const& rect : ui.damage()) {
+                SDL_RenderFillRect(data.renderer, &rect);
+            }
+            ui.render(data.renderer);
+            SDL_SetRenderTarget(data.renderer, nullptr);
+
+            // Update screen
+            SDL_RenderCopy(data.renderer, data.canvas, nullptr, nullptr);
+            SDL_RenderPresent(data.renderer);
+        }
 
-        auto current_frame = SDL_GetTicks();
+        auto current_frame = replay::getTicks();
         std::this_thread::sleep_for(std::chrono::milliseconds(std::max(0, 30-static_cast<int>(current_frame-last_frame))));
         last_frame = current_frame;
     }
@@ -167,13 +208,16 @@ auto loadData(ProgramData& data) -> bool {
     // Get window surface
     data.screen_surface = SDL_GetWindowSurface(data.window);
 
+    data.canvas = createTargetTexture(data.renderer, SCREEN_WIDTH, SCREEN_HEIGHT);
+    if (!data.canvas) { return false; }
+
     data.font = loadFont("fonts/lazy.ttf", 28);
 
-    data.texture_prompt_pause = loadTextureFromText(data.renderer, "Press S to Reset timer", data.font, SDL_Colour{0, 0, 0, 0xff});
-    if (!data.texture_prompt_pause) { return false; }
+    data.texture_prompt_pause = ManagedSDLTexture{loadTextureFromText(data.renderer, "Press S to Reset timer", data.font, SDL_Colour{0, 0, 0, 0xff})};
+    if (!data.texture_prompt_pause.texture()) { return false; }
 
-    data.texture_prompt_start = loadTextureFromText(data.renderer, "Press P to Pause or Unpause the Timer", data.font, SDL_Colour{0, 0, 0, 0xff});
-    if (!data.texture_prompt_start) { return false; }
+    data.texture_prompt_start = ManagedSDLTexture{loadTextureFromText(data.renderer, "Press P to Pause or Unpause the Timer", data.font, SDL_Colour{0, 0, 0, 0xff})};
+    if (!data.texture_prompt_start.texture()) { return false; }
 
     return true;
 }
@@ -13,7 +13,6 @@
 
 #include <chrono> // NOLINT [build/c++11]
 #include <thread> // NOLINT [build/c++11]
-#include <sstream>
 
 #include "SDL_helpers.hpp"
 #include "SDL_components.hpp"
@@ -31,7 +30,7 @@ struct ProgramData {
     ManagedSDLSurface   screen_surface;
     ManagedSDLRenderer  renderer;
 
-    ManagedSDLTexture   texture_fps;
+    GlyphStrip          glyphs;
 
     ManagedTTFFont      font;
 };
@@ -52,15 +51,18 @@ int main(__attribute__((unused))int argc, __attribute__((unused))char *argv[]) {
 
 auto run() -> bool {
     auto data       = ProgramData{};
-    auto event      = SDL_Event{};
+    auto event      = TimedEvent{};
+    auto input      = InputThread{};
     auto quit       = false;
 
     auto black      = SDL_Colour{0, 0, 0, 0xff};
-    auto time_text  = std::stringstream{};
+    auto time_text  = HudText{};
+    auto arena      = FrameArena{};
 
     auto timer      = Timer{};
 
     auto counted_frames = 0;
+    auto stats          = FrameStats{};
 
     if (!init()) {
         cout << "Failed to initialize.\n";
@@ -72,46 +74,53 @@ auto run() -> bool {
         return false;
     }
 
+    input.start();
+
     timer.reset();
     while (!quit) {
+        stats.beginFrame();
+        allocations::beginFrame();
+        // Debug builds stop here if the last frame still went to the heap once the loop has settled
+        allocations::expectSteady(arena.reset());
+
         // Handle events on queue
-        while (SDL_PollEvent(&event) != 0) {
+        while (input.poll(&event)) {
             // User requests quit
-            if (event.type == SDL_QUIT) {
+            if (event.event.type == SDL_QUIT) {
                 quit = true;
             }
 
-            mouse::update(event);
+            mouse::update(event.event);
         }
 
         auto avg_fps = counted_frames / (timer.elapsed() / 1000.f);
 
-        time_text.str("");
-        time_text << "Average frames per second: " << avg_fps;
-
-        // Render text
-        data.texture_fps = loadTextureFromText(data.renderer, time_text.str().c_str(), data.font, black);
-        if (!data.texture_fps) {
-            cout << "Unable to render time texture.\n";
-        }
+        // Drawn from the glyph strip, so updating the counter every frame rasterises nothing
+        time_text.clear().append("Average frames per second: ").append(avg_fps, 2)
+                 .append(" (p99 ").append(stats.total().p99 / 1e6, 2).append(" ms)");
 
-        auto clip_fps = SDL_Rect{100,
-                                 (SCREEN_HEIGHT-data.texture_fps.rect().h) / 2,
-                                 data.texture_fps.rect().w,
-                                 data.texture_fps.rect().h};
+        // Events are stamped when they're pumped, and off the dummy driver only this thread may pump,
+        // so pumping again between the stages of the frame is what keeps stamps finer than a frame
+        input.pump();
 
         // Clear screen
         SDL_SetRenderDrawColor(data.renderer, 0xFF, 0xFF, 0xFF, 0xFF);
         SDL_RenderClear(data.renderer);
 
-        data.texture_fps.render(data.renderer, &clip_fps);
+        data.glyphs.render(data.renderer, arena, time_text.text(), {100, (SCREEN_HEIGHT-data.glyphs.height()) / 2}, black);
+
+        input.pump();
 
         // Update screen
+        stats.beginPresent();
         SDL_RenderPresent(data.renderer);
+        stats.endPresent();
 
         counted_frames++;
     }
 
+    stats.dump("frame_stats.txt");
+
     return true;
 }
 
@@ -140,6 +149,8 @@ auto loadData(ProgramData& data) -> bool {
     data.font = loadFont("fonts/lazy.ttf", 28);
     if (!data.font) { return false; }
 
+    if (!data.glyphs.build(data.renderer, data.font)) { return false; }
+
     // data.texture_prompt_pause = loadTextureFromText(data.renderer, "Press S to Reset timer", data.font, SDL_Colour{0, 0, 0, 0xff});
     // if (!data.texture_prompt_pause) { return false; }
 
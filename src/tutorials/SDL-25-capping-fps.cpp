@@ -13,7 +13,6 @@
 
 #include <chrono> // NOLINT [build/c++11]
 #include <thread> // NOLINT [build/c++11]
-#include <sstream>
 
 #include "SDL_helpers.hpp"
 #include "SDL_components.hpp"
@@ -26,7 +25,7 @@ const auto SCREEN_WIDTH = 640;
 const auto SCREEN_HEIGHT = 480;
 
 const auto FPS = 60;
-const auto TICKS_PER_FRAME = 1000 / FPS;
+const auto NS_PER_FRAME = Uint64{1'000'000'000} / FPS;
 
 
 struct ProgramData {
@@ -34,7 +33,7 @@ struct ProgramData {
     ManagedSDLSurface   screen_surface;
     ManagedSDLRenderer  renderer;
 
-    ManagedSDLTexture   texture_fps;
+    GlyphStrip          glyphs;
 
     ManagedTTFFont      font;
 };
@@ -57,13 +56,15 @@ auto run() -> bool {
     auto data           = ProgramData{};
     auto event          = SDL_Event{};
     auto quit           = false;
-    auto last_frame     = Uint32{0};
     auto frame_timer    = Timer{};
+    auto pacer          = FramePacer{NS_PER_FRAME};
 
     auto black      = SDL_Colour{0, 0, 0, 0xff};
-    auto time_text  = std::stringstream{};
+    auto time_text  = HudText{};
+    auto arena      = FrameArena{};
 
     auto counted_frames = 0;
+    auto stats          = FrameStats{};
 
     if (!init()) {
         cout << "Failed to initialize.\n";
@@ -76,49 +77,64 @@ auto run() -> bool {
     }
 
     frame_timer.reset();
+    pacer.reset();
     while (!quit) {
-        // Handle events on queue
-        while (SDL_PollEvent(&event) != 0) {
-            // User requests quit
-            if (event.type == SDL_QUIT) {
-                quit = true;
+        stats.beginFrame();
+        allocations::beginFrame();
+        // Debug builds stop here if the last frame still went to the heap once the loop has settled
+        allocations::expectSteady(arena.reset());
+        PROFILE_ZONE("frame");
+
+        {
+            PROFILE_ZONE("events");
+
+            // Handle events on queue
+            while (replay::pollEvent(&event) != 0) {
+                // User requests quit
+                if (event.type == SDL_QUIT) {
+                    quit = true;
+                }
+
+                mouse::update(event);
             }
-
-            mouse::update(event);
         }
 
-        auto avg_fps = counted_frames / (frame_timer.elapsed() / 1000.f);
+        {
+            PROFILE_ZONE("text");
 
-        time_text.str("");
-        time_text << "Average frames per second (with cap): " << avg_fps;
+            auto avg_fps = counted_frames / (frame_timer.elapsed() / 1000.f);
 
-        // Render text
-        data.texture_fps = loadTextureFromText(data.renderer, time_text.str().c_str(), data.font, black);
-        if (!data.texture_fps) {
-            cout << "Unable to render time texture.\n";
+            // Drawn from the glyph strip, so updating the counter every frame rasterises nothing
+            time_text.clear().append("Average frames per second (with cap): ").append(avg_fps, 2)
+                     .append(" (p99 ").append(stats.total().p99 / 1e6, 2).append(" ms)");
         }
 
-        auto clip_fps = SDL_Rect{2,
-                                 (SCREEN_HEIGHT-data.texture_fps.rect().h) / 2,
-                                 data.texture_fps.rect().w,
-                                 data.texture_fps.rect().h};
-
         // Clear screen
         SDL_SetRenderDrawColor(data.renderer, 0xFF, 0xFF, 0xFF, 0xFF);
         SDL_RenderClear(data.renderer);
 
-        data.texture_fps.render(data.renderer, &clip_fps);
+        data.glyphs.render(data.renderer, arena, time_text.text(), {2, (SCREEN_HEIGHT-data.glyphs.height()) / 2}, black);
+
+        {
+            PROFILE_ZONE("present");
 
-        // Update screen
-        SDL_RenderPresent(data.renderer);
+            // Update screen
+            stats.beginPresent();
+            SDL_RenderPresent(data.renderer);
+            stats.endPresent();
+        }
 
-        auto current_frame = frame_timer.elapsed();
-        SDL_Delay(static_cast<Uint32>(std::max(0, TICKS_PER_FRAME-static_cast<int>(current_frame-last_frame))));
-        last_frame = frame_timer.elapsed();
+        pacer.wait();
 
         counted_frames++;
     }
 
+    stats.dump("frame_stats.txt");
+    cout << "Missed " << pacer.missed() << " of " << counted_frames << " frame deadlines\n";
+#ifdef PROFILING
+    profiler::exportChromeTrace("trace.json");
+#endif
+
     return true;
 }
 
@@ -147,6 +163,8 @@ auto loadData(ProgramData& data) -> bool {
     data.font = loadFont("fonts/lazy.ttf", 28);
     if (!data.font) { return false; }
 
+    if (!data.glyphs.build(data.renderer, data.font)) { return false; }
+
     // data.texture_prompt_pause = loadTextureFromText(data.renderer, "Press S to Reset timer", data.font, SDL_Colour{0, 0, 0, 0xff});
     // if (!data.texture_prompt_pause) { return false; }
 